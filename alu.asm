@@ -0,0 +1,4403 @@
+	org 100h
+	lxi sp,0f000h
+	lxi h,16899
+	push h
+	pop psw
+	mvi b,189
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,1539
+	push h
+	pop psw
+	mvi b,240
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,61443
+	push h
+	pop psw
+	mvi b,243
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,19714
+	push h
+	pop psw
+	mvi b,199
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,5394
+	push h
+	pop psw
+	mvi b,154
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,50707
+	push h
+	pop psw
+	mvi b,218
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,47874
+	push h
+	pop psw
+	mvi b,49
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,28435
+	push h
+	pop psw
+	mvi b,132
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,50435
+	push h
+	pop psw
+	mvi b,179
+	ora b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,3602
+	push h
+	pop psw
+	mvi b,143
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,13587
+	push h
+	pop psw
+	mvi b,108
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,8195
+	push h
+	pop psw
+	mvi b,246
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,8706
+	push h
+	pop psw
+	mvi b,210
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,55810
+	push h
+	pop psw
+	mvi b,212
+	ana b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,5907
+	push h
+	pop psw
+	mvi b,193
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,30723
+	push h
+	pop psw
+	mvi b,18
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,14098
+	push h
+	pop psw
+	mvi b,16
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,34322
+	push h
+	pop psw
+	mvi b,79
+	ana b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,47123
+	push h
+	pop psw
+	mvi b,70
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,50451
+	push h
+	pop psw
+	mvi b,52
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,30995
+	push h
+	pop psw
+	mvi b,154
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,39698
+	push h
+	pop psw
+	mvi b,173
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,41219
+	push h
+	pop psw
+	mvi b,10
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,43539
+	push h
+	pop psw
+	mvi b,238
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,36354
+	push h
+	pop psw
+	mvi b,250
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,2579
+	push h
+	pop psw
+	mvi b,189
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,41731
+	push h
+	pop psw
+	mvi b,90
+	ana b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,48403
+	push h
+	pop psw
+	mvi b,135
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,3331
+	push h
+	pop psw
+	mvi b,67
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,35075
+	push h
+	pop psw
+	mvi b,122
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,56850
+	push h
+	pop psw
+	mvi b,49
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,29186
+	push h
+	pop psw
+	mvi b,224
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,28419
+	push h
+	pop psw
+	mvi b,230
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,4355
+	push h
+	pop psw
+	mvi b,97
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,44547
+	push h
+	pop psw
+	mvi b,43
+	ana b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,38163
+	push h
+	pop psw
+	mvi b,138
+	ora b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,54547
+	push h
+	pop psw
+	mvi b,148
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,54018
+	push h
+	pop psw
+	mvi b,79
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,56850
+	push h
+	pop psw
+	mvi b,113
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,37634
+	push h
+	pop psw
+	mvi b,174
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,37378
+	push h
+	pop psw
+	mvi b,61
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,25858
+	push h
+	pop psw
+	mvi b,220
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,15619
+	push h
+	pop psw
+	mvi b,87
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,2562
+	push h
+	pop psw
+	mvi b,211
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,16387
+	push h
+	pop psw
+	mvi b,129
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,28930
+	push h
+	pop psw
+	mvi b,101
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,31234
+	push h
+	pop psw
+	mvi b,140
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,52227
+	push h
+	pop psw
+	mvi b,25
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,55315
+	push h
+	pop psw
+	mvi b,26
+	ana b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,7170
+	push h
+	pop psw
+	mvi b,64
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,8962
+	push h
+	pop psw
+	mvi b,247
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,64018
+	push h
+	pop psw
+	mvi b,161
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,45843
+	push h
+	pop psw
+	mvi b,197
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,34579
+	push h
+	pop psw
+	mvi b,97
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,16643
+	push h
+	pop psw
+	mvi b,1
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,23315
+	push h
+	pop psw
+	mvi b,21
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,49667
+	push h
+	pop psw
+	mvi b,22
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,65043
+	push h
+	pop psw
+	mvi b,161
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,2322
+	push h
+	pop psw
+	mvi b,125
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,9234
+	push h
+	pop psw
+	mvi b,217
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,3603
+	push h
+	pop psw
+	mvi b,166
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,60675
+	push h
+	pop psw
+	mvi b,63
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,13315
+	push h
+	pop psw
+	mvi b,2
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,50946
+	push h
+	pop psw
+	mvi b,22
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,49170
+	push h
+	pop psw
+	mvi b,91
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,3347
+	push h
+	pop psw
+	mvi b,58
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,39170
+	push h
+	pop psw
+	mvi b,45
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,13059
+	push h
+	pop psw
+	mvi b,31
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,31506
+	push h
+	pop psw
+	mvi b,92
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,51475
+	push h
+	pop psw
+	mvi b,129
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,54787
+	push h
+	pop psw
+	mvi b,42
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,20995
+	push h
+	pop psw
+	mvi b,212
+	ora b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,52482
+	push h
+	pop psw
+	mvi b,76
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,63234
+	push h
+	pop psw
+	mvi b,226
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,25859
+	push h
+	pop psw
+	mvi b,75
+	ana b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,38659
+	push h
+	pop psw
+	mvi b,211
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,2835
+	push h
+	pop psw
+	mvi b,137
+	ana b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,22546
+	push h
+	pop psw
+	mvi b,184
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,18691
+	push h
+	pop psw
+	mvi b,214
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,3602
+	push h
+	pop psw
+	mvi b,246
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,61186
+	push h
+	pop psw
+	mvi b,117
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,33298
+	push h
+	pop psw
+	mvi b,123
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,24323
+	push h
+	pop psw
+	mvi b,18
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,40963
+	push h
+	pop psw
+	mvi b,93
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,15379
+	push h
+	pop psw
+	mvi b,47
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,46595
+	push h
+	pop psw
+	mvi b,231
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,43795
+	push h
+	pop psw
+	mvi b,169
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,10003
+	push h
+	pop psw
+	mvi b,107
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,41731
+	push h
+	pop psw
+	mvi b,61
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,56595
+	push h
+	pop psw
+	mvi b,57
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,48915
+	push h
+	pop psw
+	mvi b,188
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,34563
+	push h
+	pop psw
+	mvi b,54
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,64530
+	push h
+	pop psw
+	mvi b,180
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,23826
+	push h
+	pop psw
+	mvi b,76
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,59394
+	push h
+	pop psw
+	mvi b,63
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,55058
+	push h
+	pop psw
+	mvi b,153
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,40706
+	push h
+	pop psw
+	mvi b,90
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,51218
+	push h
+	pop psw
+	mvi b,183
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,50178
+	push h
+	pop psw
+	mvi b,27
+	ana b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,35347
+	push h
+	pop psw
+	mvi b,126
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,58643
+	push h
+	pop psw
+	mvi b,35
+	ora b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,19714
+	push h
+	pop psw
+	mvi b,138
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,14610
+	push h
+	pop psw
+	mvi b,94
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,51218
+	push h
+	pop psw
+	mvi b,65
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,22290
+	push h
+	pop psw
+	mvi b,91
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,38419
+	push h
+	pop psw
+	mvi b,15
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,41235
+	push h
+	pop psw
+	mvi b,158
+	ora b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,63234
+	push h
+	pop psw
+	mvi b,15
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,30482
+	push h
+	pop psw
+	mvi b,251
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,25362
+	push h
+	pop psw
+	mvi b,108
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,37138
+	push h
+	pop psw
+	mvi b,78
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,6403
+	push h
+	pop psw
+	mvi b,13
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,10002
+	push h
+	pop psw
+	mvi b,255
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,43010
+	push h
+	pop psw
+	mvi b,176
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,4355
+	push h
+	pop psw
+	mvi b,40
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,26130
+	push h
+	pop psw
+	mvi b,223
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,14083
+	push h
+	pop psw
+	mvi b,21
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,21011
+	push h
+	pop psw
+	mvi b,200
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,55315
+	push h
+	pop psw
+	mvi b,106
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,60691
+	push h
+	pop psw
+	mvi b,234
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,59667
+	push h
+	pop psw
+	mvi b,19
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,58627
+	push h
+	pop psw
+	mvi b,185
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,27395
+	push h
+	pop psw
+	mvi b,132
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,25346
+	push h
+	pop psw
+	mvi b,81
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,52738
+	push h
+	pop psw
+	mvi b,86
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,22019
+	push h
+	pop psw
+	mvi b,226
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,2835
+	push h
+	pop psw
+	mvi b,206
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,4114
+	push h
+	pop psw
+	mvi b,26
+	ora b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,51970
+	push h
+	pop psw
+	mvi b,252
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,12291
+	push h
+	pop psw
+	mvi b,199
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,43523
+	push h
+	pop psw
+	mvi b,59
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,6675
+	push h
+	pop psw
+	mvi b,148
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,64003
+	push h
+	pop psw
+	mvi b,127
+	ana b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,45058
+	push h
+	pop psw
+	mvi b,162
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,56834
+	push h
+	pop psw
+	mvi b,45
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,11778
+	push h
+	pop psw
+	mvi b,9
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,6915
+	push h
+	pop psw
+	mvi b,96
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,44547
+	push h
+	pop psw
+	mvi b,245
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,39954
+	push h
+	pop psw
+	mvi b,201
+	ora b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,54035
+	push h
+	pop psw
+	mvi b,58
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,52755
+	push h
+	pop psw
+	mvi b,89
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,47363
+	push h
+	pop psw
+	mvi b,212
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,62979
+	push h
+	pop psw
+	mvi b,176
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,50690
+	push h
+	pop psw
+	mvi b,249
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,2818
+	push h
+	pop psw
+	mvi b,239
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,30994
+	push h
+	pop psw
+	mvi b,28
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,43522
+	push h
+	pop psw
+	mvi b,189
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,52243
+	push h
+	pop psw
+	mvi b,53
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,58882
+	push h
+	pop psw
+	mvi b,41
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,19970
+	push h
+	pop psw
+	mvi b,73
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,37650
+	push h
+	pop psw
+	mvi b,106
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,41731
+	push h
+	pop psw
+	mvi b,96
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,10242
+	push h
+	pop psw
+	mvi b,21
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,26114
+	push h
+	pop psw
+	mvi b,130
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,52242
+	push h
+	pop psw
+	mvi b,114
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,45315
+	push h
+	pop psw
+	mvi b,206
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,58114
+	push h
+	pop psw
+	mvi b,194
+	ana b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,771
+	push h
+	pop psw
+	mvi b,237
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,45315
+	push h
+	pop psw
+	mvi b,98
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,47618
+	push h
+	pop psw
+	mvi b,216
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,45827
+	push h
+	pop psw
+	mvi b,31
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,57347
+	push h
+	pop psw
+	mvi b,43
+	ora b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,21522
+	push h
+	pop psw
+	mvi b,105
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,54802
+	push h
+	pop psw
+	mvi b,188
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,53266
+	push h
+	pop psw
+	mvi b,240
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,24066
+	push h
+	pop psw
+	mvi b,49
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,7938
+	push h
+	pop psw
+	mvi b,241
+	ana b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,36099
+	push h
+	pop psw
+	mvi b,251
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,61187
+	push h
+	pop psw
+	mvi b,100
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,58131
+	push h
+	pop psw
+	mvi b,153
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,26899
+	push h
+	pop psw
+	mvi b,78
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,48659
+	push h
+	pop psw
+	mvi b,82
+	ora b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,61971
+	push h
+	pop psw
+	mvi b,113
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,3859
+	push h
+	pop psw
+	mvi b,237
+	ana b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,31746
+	push h
+	pop psw
+	mvi b,5
+	ana b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,19458
+	push h
+	pop psw
+	mvi b,10
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,26643
+	push h
+	pop psw
+	mvi b,238
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,4354
+	push h
+	pop psw
+	mvi b,250
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,36099
+	push h
+	pop psw
+	mvi b,221
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,12307
+	push h
+	pop psw
+	mvi b,230
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,65299
+	push h
+	pop psw
+	mvi b,214
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,3842
+	push h
+	pop psw
+	mvi b,219
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,32275
+	push h
+	pop psw
+	mvi b,69
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,17410
+	push h
+	pop psw
+	mvi b,143
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,2066
+	push h
+	pop psw
+	mvi b,248
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,54290
+	push h
+	pop psw
+	mvi b,189
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,9490
+	push h
+	pop psw
+	mvi b,71
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,58131
+	push h
+	pop psw
+	mvi b,232
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,36867
+	push h
+	pop psw
+	mvi b,79
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,4867
+	push h
+	pop psw
+	mvi b,210
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,35587
+	push h
+	pop psw
+	mvi b,15
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,16387
+	push h
+	pop psw
+	mvi b,143
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,9746
+	push h
+	pop psw
+	mvi b,190
+	ora b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,58643
+	push h
+	pop psw
+	mvi b,99
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,50179
+	push h
+	pop psw
+	mvi b,203
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,27923
+	push h
+	pop psw
+	mvi b,19
+	ana b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,51202
+	push h
+	pop psw
+	mvi b,144
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,32786
+	push h
+	pop psw
+	mvi b,211
+	ora b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,26114
+	push h
+	pop psw
+	mvi b,40
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,530
+	push h
+	pop psw
+	mvi b,144
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,63251
+	push h
+	pop psw
+	mvi b,236
+	ana b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,6162
+	push h
+	pop psw
+	mvi b,89
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,18706
+	push h
+	pop psw
+	mvi b,76
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,51986
+	push h
+	pop psw
+	mvi b,4
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,23555
+	push h
+	pop psw
+	mvi b,90
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,16898
+	push h
+	pop psw
+	mvi b,75
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,27922
+	push h
+	pop psw
+	mvi b,195
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,23811
+	push h
+	pop psw
+	mvi b,13
+	ora b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,14851
+	push h
+	pop psw
+	mvi b,74
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,46082
+	push h
+	pop psw
+	mvi b,39
+	ora b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,18434
+	push h
+	pop psw
+	mvi b,244
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,63507
+	push h
+	pop psw
+	mvi b,53
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,45075
+	push h
+	pop psw
+	mvi b,226
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,39954
+	push h
+	pop psw
+	mvi b,226
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,26130
+	push h
+	pop psw
+	mvi b,151
+	ora b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,41474
+	push h
+	pop psw
+	mvi b,136
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,7426
+	push h
+	pop psw
+	mvi b,209
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,1810
+	push h
+	pop psw
+	mvi b,80
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,48914
+	push h
+	pop psw
+	mvi b,140
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,57602
+	push h
+	pop psw
+	mvi b,166
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,59667
+	push h
+	pop psw
+	mvi b,191
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,45075
+	push h
+	pop psw
+	mvi b,174
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,23826
+	push h
+	pop psw
+	mvi b,63
+	ana b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,32531
+	push h
+	pop psw
+	mvi b,144
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,16899
+	push h
+	pop psw
+	mvi b,244
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,57874
+	push h
+	pop psw
+	mvi b,26
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,38162
+	push h
+	pop psw
+	mvi b,30
+	ora b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,27651
+	push h
+	pop psw
+	mvi b,38
+	ora b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,64531
+	push h
+	pop psw
+	mvi b,60
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,47379
+	push h
+	pop psw
+	mvi b,6
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,48403
+	push h
+	pop psw
+	mvi b,204
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,13586
+	push h
+	pop psw
+	mvi b,253
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,2
+	push h
+	pop psw
+	mvi b,189
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,10515
+	push h
+	pop psw
+	mvi b,107
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,25618
+	push h
+	pop psw
+	mvi b,15
+	ana b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,58130
+	push h
+	pop psw
+	mvi b,186
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,15634
+	push h
+	pop psw
+	mvi b,193
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,40194
+	push h
+	pop psw
+	mvi b,146
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,11026
+	push h
+	pop psw
+	mvi b,220
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,786
+	push h
+	pop psw
+	mvi b,250
+	ora b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,18194
+	push h
+	pop psw
+	mvi b,199
+	ana b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,38915
+	push h
+	pop psw
+	mvi b,223
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,10771
+	push h
+	pop psw
+	mvi b,32
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,1043
+	push h
+	pop psw
+	mvi b,166
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,12291
+	push h
+	pop psw
+	mvi b,169
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,26370
+	push h
+	pop psw
+	mvi b,200
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,3330
+	push h
+	pop psw
+	mvi b,122
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,61459
+	push h
+	pop psw
+	mvi b,202
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,29715
+	push h
+	pop psw
+	mvi b,103
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,17427
+	push h
+	pop psw
+	mvi b,186
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,26642
+	push h
+	pop psw
+	mvi b,228
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,25346
+	push h
+	pop psw
+	mvi b,252
+	ana b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,59651
+	push h
+	pop psw
+	mvi b,61
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,24339
+	push h
+	pop psw
+	mvi b,19
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,50194
+	push h
+	pop psw
+	mvi b,29
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,50962
+	push h
+	pop psw
+	mvi b,114
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,45074
+	push h
+	pop psw
+	mvi b,134
+	ana b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,27155
+	push h
+	pop psw
+	mvi b,112
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,22019
+	push h
+	pop psw
+	mvi b,125
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,47634
+	push h
+	pop psw
+	mvi b,118
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,55571
+	push h
+	pop psw
+	mvi b,90
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,7187
+	push h
+	pop psw
+	mvi b,40
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,23059
+	push h
+	pop psw
+	mvi b,137
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,50963
+	push h
+	pop psw
+	mvi b,248
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,63250
+	push h
+	pop psw
+	mvi b,91
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,18706
+	push h
+	pop psw
+	mvi b,164
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,19203
+	push h
+	pop psw
+	mvi b,152
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,48914
+	push h
+	pop psw
+	mvi b,252
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,26387
+	push h
+	pop psw
+	mvi b,47
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,42243
+	push h
+	pop psw
+	mvi b,210
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,45843
+	push h
+	pop psw
+	mvi b,216
+	ora b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,23555
+	push h
+	pop psw
+	mvi b,127
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,50435
+	push h
+	pop psw
+	mvi b,56
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,63507
+	push h
+	pop psw
+	mvi b,88
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,53506
+	push h
+	pop psw
+	mvi b,187
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,62978
+	push h
+	pop psw
+	mvi b,103
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,13075
+	push h
+	pop psw
+	mvi b,60
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,35859
+	push h
+	pop psw
+	mvi b,33
+	ora b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,40963
+	push h
+	pop psw
+	mvi b,117
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,14355
+	push h
+	pop psw
+	mvi b,244
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,34322
+	push h
+	pop psw
+	mvi b,189
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,26130
+	push h
+	pop psw
+	mvi b,114
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,44802
+	push h
+	pop psw
+	mvi b,54
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,29443
+	push h
+	pop psw
+	mvi b,234
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,18450
+	push h
+	pop psw
+	mvi b,84
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,17427
+	push h
+	pop psw
+	mvi b,190
+	ana b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,55827
+	push h
+	pop psw
+	mvi b,220
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,35586
+	push h
+	pop psw
+	mvi b,198
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,22274
+	push h
+	pop psw
+	mvi b,220
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,27139
+	push h
+	pop psw
+	mvi b,190
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,46850
+	push h
+	pop psw
+	mvi b,103
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,9491
+	push h
+	pop psw
+	mvi b,248
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,15122
+	push h
+	pop psw
+	mvi b,172
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,11266
+	push h
+	pop psw
+	mvi b,40
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,10771
+	push h
+	pop psw
+	mvi b,200
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,23058
+	push h
+	pop psw
+	mvi b,1
+	ana b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,54274
+	push h
+	pop psw
+	mvi b,87
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,42754
+	push h
+	pop psw
+	mvi b,185
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,50707
+	push h
+	pop psw
+	mvi b,5
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,29187
+	push h
+	pop psw
+	mvi b,225
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,45058
+	push h
+	pop psw
+	mvi b,110
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,51219
+	push h
+	pop psw
+	mvi b,49
+	ora b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,14851
+	push h
+	pop psw
+	mvi b,124
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,52995
+	push h
+	pop psw
+	mvi b,13
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,59395
+	push h
+	pop psw
+	mvi b,135
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,55810
+	push h
+	pop psw
+	mvi b,157
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,13074
+	push h
+	pop psw
+	mvi b,145
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,16386
+	push h
+	pop psw
+	mvi b,157
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,38674
+	push h
+	pop psw
+	mvi b,62
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,62723
+	push h
+	pop psw
+	mvi b,126
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,2818
+	push h
+	pop psw
+	mvi b,242
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,62738
+	push h
+	pop psw
+	mvi b,6
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,38675
+	push h
+	pop psw
+	mvi b,156
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,39939
+	push h
+	pop psw
+	mvi b,67
+	ana b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,5634
+	push h
+	pop psw
+	mvi b,58
+	ora b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,20738
+	push h
+	pop psw
+	mvi b,200
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,39427
+	push h
+	pop psw
+	mvi b,3
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,65299
+	push h
+	pop psw
+	mvi b,43
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,51219
+	push h
+	pop psw
+	mvi b,222
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,3603
+	push h
+	pop psw
+	mvi b,165
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,33795
+	push h
+	pop psw
+	mvi b,242
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,12563
+	push h
+	pop psw
+	mvi b,134
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,26370
+	push h
+	pop psw
+	mvi b,172
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,6162
+	push h
+	pop psw
+	mvi b,205
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,41746
+	push h
+	pop psw
+	mvi b,50
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,56339
+	push h
+	pop psw
+	mvi b,215
+	ana b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,5139
+	push h
+	pop psw
+	mvi b,186
+	ora b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,35586
+	push h
+	pop psw
+	mvi b,112
+	ora b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,3858
+	push h
+	pop psw
+	mvi b,211
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,62467
+	push h
+	pop psw
+	mvi b,193
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,51714
+	push h
+	pop psw
+	mvi b,29
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,12547
+	push h
+	pop psw
+	mvi b,70
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,13571
+	push h
+	pop psw
+	mvi b,109
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,56834
+	push h
+	pop psw
+	mvi b,74
+	ora b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,55315
+	push h
+	pop psw
+	mvi b,254
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,3602
+	push h
+	pop psw
+	mvi b,130
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,50450
+	push h
+	pop psw
+	mvi b,109
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,11011
+	push h
+	pop psw
+	mvi b,105
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,43538
+	push h
+	pop psw
+	mvi b,117
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,39698
+	push h
+	pop psw
+	mvi b,110
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,38930
+	push h
+	pop psw
+	mvi b,122
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,9219
+	push h
+	pop psw
+	mvi b,128
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,20226
+	push h
+	pop psw
+	mvi b,176
+	ana b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,15123
+	push h
+	pop psw
+	mvi b,232
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,51715
+	push h
+	pop psw
+	mvi b,135
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,26627
+	push h
+	pop psw
+	mvi b,159
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,55043
+	push h
+	pop psw
+	mvi b,204
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,16130
+	push h
+	pop psw
+	mvi b,62
+	ana b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,45074
+	push h
+	pop psw
+	mvi b,86
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,14866
+	push h
+	pop psw
+	mvi b,162
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,37907
+	push h
+	pop psw
+	mvi b,10
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,22018
+	push h
+	pop psw
+	mvi b,247
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,48403
+	push h
+	pop psw
+	mvi b,245
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,25875
+	push h
+	pop psw
+	mvi b,235
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,47891
+	push h
+	pop psw
+	mvi b,5
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,64786
+	push h
+	pop psw
+	mvi b,231
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,39938
+	push h
+	pop psw
+	mvi b,95
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,22547
+	push h
+	pop psw
+	mvi b,89
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,47378
+	push h
+	pop psw
+	mvi b,2
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,6914
+	push h
+	pop psw
+	mvi b,194
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,59139
+	push h
+	pop psw
+	mvi b,178
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,56834
+	push h
+	pop psw
+	mvi b,41
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,11026
+	push h
+	pop psw
+	mvi b,103
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,43522
+	push h
+	pop psw
+	mvi b,14
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,4882
+	push h
+	pop psw
+	mvi b,63
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,39682
+	push h
+	pop psw
+	mvi b,164
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,1795
+	push h
+	pop psw
+	mvi b,111
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,58115
+	push h
+	pop psw
+	mvi b,210
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,39682
+	push h
+	pop psw
+	mvi b,144
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,43523
+	push h
+	pop psw
+	mvi b,224
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,41491
+	push h
+	pop psw
+	mvi b,149
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,38658
+	push h
+	pop psw
+	mvi b,190
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,39699
+	push h
+	pop psw
+	mvi b,233
+	ora b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,13074
+	push h
+	pop psw
+	mvi b,179
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,7187
+	push h
+	pop psw
+	mvi b,234
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,64259
+	push h
+	pop psw
+	mvi b,98
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,63491
+	push h
+	pop psw
+	mvi b,226
+	adc b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,34307
+	push h
+	pop psw
+	mvi b,68
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,26115
+	push h
+	pop psw
+	mvi b,121
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,48130
+	push h
+	pop psw
+	mvi b,98
+	ana b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,57603
+	push h
+	pop psw
+	mvi b,154
+	xra b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,41746
+	push h
+	pop psw
+	mvi b,150
+	daa
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,65043
+	push h
+	pop psw
+	mvi b,159
+	dcr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,8210
+	push h
+	pop psw
+	mvi b,103
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,9474
+	push h
+	pop psw
+	mvi b,177
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,61955
+	push h
+	pop psw
+	mvi b,80
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,47619
+	push h
+	pop psw
+	mvi b,122
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,29970
+	push h
+	pop psw
+	mvi b,163
+	add b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,32531
+	push h
+	pop psw
+	mvi b,178
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,59395
+	push h
+	pop psw
+	mvi b,219
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,52754
+	push h
+	pop psw
+	mvi b,11
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,39938
+	push h
+	pop psw
+	mvi b,186
+	ora b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,12306
+	push h
+	pop psw
+	mvi b,208
+	sub b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,32515
+	push h
+	pop psw
+	mvi b,39
+	ora b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,48147
+	push h
+	pop psw
+	mvi b,94
+	ana b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,2563
+	push h
+	pop psw
+	mvi b,119
+	ora b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,48387
+	push h
+	pop psw
+	mvi b,181
+	ora b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,47618
+	push h
+	pop psw
+	mvi b,0
+	sbb b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,34322
+	push h
+	pop psw
+	mvi b,99
+	cmp b
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	lxi h,57875
+	push h
+	pop psw
+	mvi b,84
+	inr a
+	push psw
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	hlt
@@ -0,0 +1,324 @@
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "a80.h"
+#include "emu.h"
+#include "source.h"
+
+/*
+ * Generate synthetic sources of a given shape and size, then time each
+ * phase of assembling them. The generator is seeded, so a given shape,
+ * size and seed always yields the same source.
+ */
+
+enum shape {
+	LABELS,		/* a label on every line */
+	DATA,		/* db and dw */
+	BRANCHES,	/* jmp, call and conditional jumps */
+	MIXED,
+	NSHAPES,
+};
+
+static const char *shapes[NSHAPES] = { "labels", "data", "branches", "mixed" };
+
+static const char *conds[] = { "jmp", "jz", "jnc", "jc", "jm", "call", "cz", "cnz" };
+static const char *regs = "bcdehla";
+
+static unsigned long long rng;
+
+static unsigned long
+rand32(void)
+{
+	/* xorshift64* */
+	rng ^= rng >> 12;
+	rng ^= rng << 25;
+	rng ^= rng >> 27;
+	return (unsigned long)((rng * 0x2545f4914f6cdd1dULL) >> 32);
+}
+
+static double
+now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+ * Labels are numbered within regions so that every reference resolves. A
+ * new region starts at org 0 before the object code outgrows the address
+ * space, so sources of any size assemble.
+ */
+static void
+generate(FILE *f, enum shape shape, size_t nlines, unsigned long long seed)
+{
+	size_t addr = 0, region = 0, nlabels = 0;
+
+	rng = seed ? seed : 1;
+	fprintf(f, "\torg 0\nr0l0:\n");
+	nlabels = 1;
+
+	for (size_t i = 2; i < nlines; ++i) {
+		enum shape s = shape == MIXED ? (enum shape)(rand32() % MIXED) : shape;
+		unsigned long r = rand32();
+
+		if (addr > 65000) {
+			fprintf(f, "\torg 0\nr%zul0:\n", ++region);
+			addr = 0;
+			nlabels = 1;
+			++i;
+			continue;
+		}
+
+		switch (s) {
+		case LABELS:
+			fprintf(f, "r%zul%zu:\tmvi %c, %lu\n", region, nlabels++,
+					regs[r % 7], (r >> 8) % 256);
+			addr += 2;
+			break;
+		case DATA:
+			if (r % 8 == 0) {
+				fprintf(f, "\tdb 'data %lu'\n", r >> 8);
+				addr += 5 + snprintf(NULL, 0, "%lu", r >> 8);
+			} else if (r % 2 == 0) {
+				fprintf(f, "\tdw %lu\n", (r >> 8) % 65536);
+				addr += 2;
+			} else {
+				fprintf(f, "\tdb %lu\n", (r >> 8) % 256);
+				addr += 1;
+			}
+			break;
+		case BRANCHES:
+			if (r % 8 == 0) {
+				fprintf(f, "r%zul%zu:\n", region, nlabels++);
+			} else {
+				fprintf(f, "\t%s r%zul%lu\n", conds[r % 8], region,
+						(r >> 8) % nlabels);
+				addr += 3;
+			}
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+static void
+run(enum shape shape, size_t nlines, unsigned long long seed, int reps)
+{
+	static struct a80_image image;
+	char path[] = "/tmp/a80benchXXXXXX";
+	double load = 0, pass1 = 0, pass2 = 0, output = 0;
+	struct source src;
+	struct a80_stats stats;
+
+	int fd = mkstemp(path);
+	FILE *f = fd < 0 ? NULL : fdopen(fd, "w");
+	if (f == NULL) {
+		perror("mkstemp");
+		exit(EXIT_FAILURE);
+	}
+	generate(f, shape, nlines, seed);
+	fclose(f);
+
+	struct a80 *ctx = a80_new();
+	FILE *devnull = fopen("/dev/null", "w");
+	if (ctx == NULL || devnull == NULL) {
+		perror("a80bench");
+		exit(EXIT_FAILURE);
+	}
+
+	for (int i = 0; i < reps; ++i) {
+		double start = now();
+		if (opensource(path, &src) != 0) {
+			perror(path);
+			exit(EXIT_FAILURE);
+		}
+		/* Touch every page so that load includes faulting them in. */
+		volatile char sink = 0;
+		for (size_t j = 0; j < src.len; j += 4096) {
+			sink ^= src.buf[j];
+		}
+		load += now() - start;
+
+		if (a80_assemble(ctx, src.buf, src.len, &image) != 0) {
+			fprintf(stderr, "a80bench %zu: %s\n", a80_errline(ctx), a80_error(ctx));
+			exit(EXIT_FAILURE);
+		}
+		a80_stats(ctx, &stats);
+		pass1 += stats.pass1;
+		pass2 += stats.pass2;
+
+		start = now();
+		fwrite(image.bytes + image.lo, 1, image.hi - image.lo, devnull);
+		fflush(devnull);
+		output += now() - start;
+
+		closesource(&src);
+	}
+
+	size_t size = 0;
+	if (opensource(path, &src) == 0) {
+		size = src.len;
+		closesource(&src);
+	}
+	double total = (load + pass1 + pass2 + output) / reps;
+
+	printf("%-9s %9zu %9.2f %9.2f %9.2f %9.2f %12.0f %9.1f\n",
+			shapes[shape], stats.lines,
+			load / reps * 1e3, pass1 / reps * 1e3,
+			pass2 / reps * 1e3, output / reps * 1e3,
+			stats.lines / total, size / total / 1e6);
+
+	fclose(devnull);
+	a80_free(ctx);
+	unlink(path);
+}
+
+/*
+ * A loop of loads, stores, arithmetic and calls that never halts, for
+ * timing the emulator over a given number of instructions.
+ */
+static const char program[] =
+	"\torg 100h\n"
+	"\tlxi sp,0\n"
+	"outer:\tlxi h,buf\n"
+	"\tmvi b,0\n"
+	"inner:\tmov a,m\n"
+	"\tadd b\n"
+	"\tmov m,a\n"
+	"\tinx h\n"
+	"\tcall step\n"
+	"\tdcr b\n"
+	"\tjnz inner\n"
+	"\tjmp outer\n"
+	"step:\txra c\n"
+	"\trlc\n"
+	"\tmov c,a\n"
+	"\tret\n"
+	"buf:\tds 256\n";
+
+static void
+emulate(unsigned long long steps, int reps)
+{
+	static struct a80_image image;
+	struct cpu *cpu = malloc(sizeof(*cpu));
+	struct a80 *ctx = a80_new();
+	double elapsed = 0;
+
+	if (cpu == NULL || ctx == NULL) {
+		perror("a80bench");
+		exit(EXIT_FAILURE);
+	}
+	if (a80_assemble(ctx, program, sizeof(program) - 1, &image) != 0) {
+		fprintf(stderr, "a80bench %zu: %s\n", a80_errline(ctx), a80_error(ctx));
+		exit(EXIT_FAILURE);
+	}
+
+	for (int i = 0; i < reps; ++i) {
+		cpuinit(cpu, &image, NULL, NULL);
+		double start = now();
+		cpurun(cpu, steps);
+		elapsed += now() - start;
+	}
+
+	printf("%-9s %12s %9s %9s\n", "emulated", "steps", "ms", "MIPS");
+	printf("%-9s %12llu %9.2f %9.1f\n", "loop", steps,
+			elapsed / reps * 1e3, steps * reps / elapsed / 1e6);
+
+	a80_free(ctx);
+	free(cpu);
+}
+
+static void
+usage(char *argv0)
+{
+	fprintf(stderr, "usage: %s [-n lines] [-r reps] [-s seed] [-o file] [shape]...\n"
+			"       %s [-r reps] -e millions\n", argv0, argv0);
+	fprintf(stderr, "shapes: labels data branches mixed\n");
+	exit(EXIT_FAILURE);
+}
+
+int
+main(int argc, char *argv[])
+{
+	size_t nlines = 200000;
+	unsigned long long seed = 1;
+	int reps = 5;
+	const char *out = NULL;
+	unsigned long long steps = 0;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "e:n:r:s:o:")) != -1) {
+		switch (opt) {
+		case 'e':
+			steps = strtoull(optarg, NULL, 10) * 1000000;
+			break;
+		case 'n':
+			nlines = strtoul(optarg, NULL, 10);
+			break;
+		case 'r':
+			reps = atoi(optarg);
+			break;
+		case 's':
+			seed = strtoull(optarg, NULL, 10);
+			break;
+		case 'o':
+			out = optarg;
+			break;
+		default:
+			usage(argv[0]);
+		}
+	}
+	if (nlines < 2 || reps < 1) {
+		usage(argv[0]);
+	}
+
+	/* With -e, time the emulator instead of the assembler. */
+	if (steps > 0) {
+		emulate(steps, reps);
+		exit(EXIT_SUCCESS);
+	}
+
+	int selected[NSHAPES] = { 0 };
+	int any = 0;
+	for (int i = optind; i < argc; ++i) {
+		int found = 0;
+		for (int s = 0; s < NSHAPES; ++s) {
+			if (strcmp(argv[i], shapes[s]) == 0) {
+				selected[s] = found = any = 1;
+			}
+		}
+		if (!found) {
+			usage(argv[0]);
+		}
+	}
+
+	/* With -o, write the source of the first shape and stop. */
+	if (out != NULL) {
+		int s = 0;
+		while (any && !selected[s]) ++s;
+		FILE *f = fopen(out, "w");
+		if (f == NULL) {
+			perror(out);
+			exit(EXIT_FAILURE);
+		}
+		generate(f, (enum shape)s, nlines, seed);
+		fclose(f);
+		exit(EXIT_SUCCESS);
+	}
+
+	printf("%-9s %9s %9s %9s %9s %9s %12s %9s\n", "shape", "lines",
+			"load ms", "pass1 ms", "pass2 ms", "write ms", "lines/s", "MB/s");
+	for (int s = 0; s < NSHAPES; ++s) {
+		if (!any || selected[s]) {
+			run((enum shape)s, nlines, seed, reps);
+		}
+	}
+
+	exit(EXIT_SUCCESS);
+}
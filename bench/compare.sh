@@ -0,0 +1,102 @@
+#!/usr/bin/env sh
+#
+# Time the a80 of two revisions on the same generated sources, to measure
+# a change from before to after it. Each revision is checked out into a
+# temporary worktree and built with -O2; the sources come from a80bench -o,
+# built from the working tree, so both revisions read the same input. The
+# best of the repetitions of each run is reported, in milliseconds, and so
+# is the best time in the first pass where both revisions report it with
+# --stats=json.
+#
+#     sh bench/compare.sh [-n lines] [-r reps] old new [shape]...
+#
+# Revisions from before a80 handled labels efficiently take quadratic time
+# over them, so compare those on the data shape.
+
+CC="gcc"
+FLAGS="-O2"
+LIBS="-lpthread"
+NLINES=300000
+REPS=5
+
+usage() {
+	echo "usage: $0 [-n lines] [-r reps] old new [shape]..." >&2
+	exit 1
+}
+
+while getopts "n:r:" opt; do
+	case "$opt" in
+	n) NLINES="$OPTARG" ;;
+	r) REPS="$OPTARG" ;;
+	*) usage ;;
+	esac
+done
+shift $((OPTIND - 1))
+[ $# -ge 2 ] || usage
+OLD="$1"
+NEW="$2"
+shift 2
+SHAPES="${*:-mixed}"
+
+TMP=$(mktemp -d) || exit 1
+trap 'git worktree remove --force "$TMP/old" 2>/dev/null;
+	git worktree remove --force "$TMP/new" 2>/dev/null; rm -rf "$TMP"' EXIT
+
+# Build the a80 of revision $2 as $1/a80.
+build() {
+	git worktree add -q --detach "$1" "$2" || exit 1
+	$CC $FLAGS -o "$1/a80" "$1"/src/*.c $LIBS || exit 1
+}
+
+# Print the milliseconds of the fastest of $REPS runs of a80 $1 on $2, and
+# of the fastest first pass among them, or - if $1 does not report it.
+best() {
+	best=
+	pass1=
+	stats=--stats=json
+	"$1" $stats "$2" >/dev/null 2>"$TMP/stats" && grep -q '"pass1"' "$TMP/stats" \
+		|| stats=
+	: >"$TMP/stats"
+	i=0
+	while [ $i -lt "$REPS" ]; do
+		start=$(date +%s%N)
+		"$1" $stats "$2" >/dev/null 2>"$TMP/stats" \
+			|| { echo "$1 failed on $2" >&2; exit 1; }
+		end=$(date +%s%N)
+		t=$(((end - start) / 1000))
+		if [ -z "$best" ] || [ $t -lt "$best" ]; then
+			best=$t
+		fi
+		p=$(sed -n 's/.*"pass1": \([0-9.]*\).*/\1/p' "$TMP/stats")
+		if [ -n "$p" ] && { [ -z "$pass1" ] \
+				|| awk -v a="$p" -v b="$pass1" 'BEGIN { exit !(a < b) }'; }; then
+			pass1=$p
+		fi
+		i=$((i + 1))
+	done
+	awk -v us="$best" -v s="${pass1:--}" \
+		'BEGIN { printf "%.1f %s", us / 1000, s == "-" ? s : sprintf("%.1f", s * 1000) }'
+}
+
+# Print the row of a table for $1, timed at $2 before and $3 after.
+row() {
+	if [ "$2" = "-" ] || [ "$3" = "-" ]; then
+		return
+	fi
+	printf "%-9s %-6s %9s %12s %12s %7.2fx\n" "$shape" "$1" "$NLINES" "$2" "$3" \
+		"$(awk -v a="$2" -v b="$3" 'BEGIN { print a / b }')"
+}
+
+build "$TMP/old" "$OLD"
+build "$TMP/new" "$NEW"
+$CC $FLAGS -Isrc -o "$TMP/a80bench" bench/bench.c $(ls src/*.c | grep -v '/a80\.c$') $LIBS \
+	|| exit 1
+
+printf "%-9s %-6s %9s %12s %12s %8s\n" "shape" "time" "lines" "old ms" "new ms" "speedup"
+for shape in $SHAPES; do
+	"$TMP/a80bench" -n "$NLINES" -o "$TMP/$shape.asm" "$shape" || exit 1
+	old=$(best "$TMP/old/a80" "$TMP/$shape.asm") || exit 1
+	new=$(best "$TMP/new/a80" "$TMP/$shape.asm") || exit 1
+	row run "${old% *}" "${new% *}"
+	row pass1 "${old#* }" "${new#* }"
+done
@@ -0,0 +1,53 @@
+/*
+ * Time parse() and process() over the first pass of a mix of lines, for
+ * the a80.c of revisions that kept the whole assembler, with both of those
+ * functions, in one file: up to and including the perfect hash of the
+ * mnemonics. Whole runs of those revisions are dominated by their
+ * quadratic list of symbols, so this times the dispatch alone. Operands
+ * are numbers, which the first pass never looks up.
+ *
+ *     gcc -O2 -I. -DA80C='"rev/src/a80.c"' -o dispatch bench/dispatch.c rev/src/list.c
+ *     ./dispatch [lines]
+ */
+#include <time.h>
+
+#define main a80main
+#include A80C
+#undef main
+
+static const char *const mix[] = {
+	"\tdb 7\n", "\tdw 4660\n", "\tds 4\n", "\tmvi a, 12\n",
+	"\tnop\n", "\tmov a, b\n", "\tcall 4660\n", "\tlxi h, 4660\n",
+};
+
+static double
+now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int
+main(int argc, char *argv[])
+{
+	size_t nlines = argc > 1 ? strtoul(argv[1], NULL, 10) : 16000000;
+	size_t nmix = sizeof(mix) / sizeof(mix[0]);
+	char buf[32];
+
+	symtabs = initlist();
+	pass = 1;
+
+	double start = now();
+	for (size_t i = 0; i < nlines; ++i) {
+		/* parse() writes into the line, so it gets a fresh copy. */
+		strcpy(buf, mix[i % nmix]);
+		parse(buf);
+		process();
+	}
+	double elapsed = now() - start;
+
+	printf("%zu lines in %.3f s, %.2fM lines/sec\n", nlines, elapsed,
+			nlines / elapsed / 1e6);
+	return 0;
+}
@@ -0,0 +1,156 @@
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "a80.h"
+#include "pool.h"
+#include "server.h"
+#include "source.h"
+
+/*
+ * A client of `a80 --serve`. It takes the same arguments as a80 and writes
+ * the same object files and diagnostics, but leaves assembly to the server
+ * listening on A80_SOCKET, so each invocation costs little more than a
+ * connection and a read of each source.
+ */
+
+struct job {
+	const char *path;
+	int ret;
+	size_t errline;
+	char err[128];
+};
+
+struct batch {
+	struct job *jobs;
+	struct a80_image *images;
+	int flags;
+	int full;
+};
+
+static void
+fail(struct job *job, const char *what)
+{
+	job->ret = -1;
+	job->errline = 0;
+	snprintf(job->err, sizeof(job->err), "%s", what);
+}
+
+static void
+runjob(void *arg, size_t worker, size_t i)
+{
+	struct batch *batch = arg;
+	struct job *job = &batch->jobs[i];
+	struct a80_image *image = &batch->images[worker];
+	struct source src;
+	int fd;
+
+	if (opensource(job->path, &src) != 0) {
+		fail(job, "unable to open source");
+		return;
+	}
+	if ((fd = connectserver(serverpath())) < 0) {
+		closesource(&src);
+		fail(job, "unable to connect to server");
+		return;
+	}
+	job->ret = remoteassemble(fd, src.buf, src.len, batch->flags,
+			image, &job->errline, job->err, sizeof(job->err));
+	close(fd);
+	closesource(&src);
+	if (job->ret != 0) {
+		return;
+	}
+
+	char *path = outpath(job->path);
+	FILE *ostream = path ? fopen(path, "w+") : NULL;
+	free(path);
+	if (ostream == NULL) {
+		fail(job, "unable to open object file");
+		return;
+	}
+	if (batch->full) {
+		fwrite(image->bytes, sizeof(unsigned char), sizeof(image->bytes), ostream);
+	} else {
+		fwrite(image->bytes + image->lo, sizeof(unsigned char),
+				image->hi - image->lo, ostream);
+	}
+	if (fclose(ostream) != 0) {
+		fail(job, "unable to write object file");
+	}
+}
+
+static void
+usage(char *argv0)
+{
+	fprintf(stderr, "usage: %s [-1f] [-j jobs] <file.asm>...\n", argv0);
+	exit(EXIT_FAILURE);
+}
+
+int
+main(int argc, char *argv[])
+{
+	size_t njobs = 1;
+	int opt;
+	int status = EXIT_SUCCESS;
+	struct batch batch = { 0 };
+
+	while ((opt = getopt(argc, argv, "1fj:")) != -1) {
+		switch (opt) {
+		case '1':
+			batch.flags |= REQ_ONEPASS;
+			break;
+		case 'f':
+			batch.full = 1;
+			break;
+		case 'j':
+			if ((njobs = strtoul(optarg, NULL, 10)) == 0) {
+				usage(argv[0]);
+			}
+			break;
+		default:
+			usage(argv[0]);
+		}
+	}
+
+	size_t npaths = argc - optind;
+	if (npaths == 0) {
+		usage(argv[0]);
+	}
+	if (njobs > npaths) {
+		njobs = npaths;
+	}
+
+	batch.jobs = calloc(npaths, sizeof(struct job));
+	batch.images = malloc(njobs * sizeof(struct a80_image));
+	if (batch.jobs == NULL || batch.images == NULL) {
+		perror("malloc");
+		exit(EXIT_FAILURE);
+	}
+	for (size_t i = 0; i < npaths; ++i) {
+		batch.jobs[i].path = argv[optind + i];
+	}
+
+	parallelfor(njobs, npaths, runjob, &batch);
+
+	for (size_t i = 0; i < npaths; ++i) {
+		struct job *job = &batch.jobs[i];
+		if (job->ret == 0) {
+			continue;
+		}
+		if (job->errline == 0) {
+			fprintf(stderr, "a80: %s: %s\n", job->path, job->err);
+		} else if (npaths > 1) {
+			fprintf(stderr, "a80 %s:%zu: %s\n", job->path, job->errline, job->err);
+		} else {
+			fprintf(stderr, "a80 %zu: %s\n", job->errline, job->err);
+		}
+		status = EXIT_FAILURE;
+	}
+
+	free(batch.images);
+	free(batch.jobs);
+
+	exit(status);
+}
@@ -0,0 +1,116 @@
+	org 100h
+	lxi sp,0f000h
+	lxi h,800h
+x0:
+	mov m,l
+x1:
+	cmc
+x2:
+	mov d,e
+x3:
+	mov d,b
+x4:
+	mov l,e
+x5:
+	cc sub
+x6:
+	cmp c
+x7:
+	push psw
+	pop b
+x8:
+	mov a,l
+x9:
+	mov c,l
+x10:
+	xra l
+x11:
+	dcx b
+x12:
+	xri 137
+x13:
+	lxi h,271
+x14:
+	rlc
+x15:
+	mov m,c
+x16:
+	lda 2212
+x17:
+	jp x44
+x18:
+	jm x24
+x19:
+	dcx b
+x20:
+	jnz x29
+x21:
+	mov l,l
+x22:
+	cnc sub
+x23:
+	cnz sub
+x24:
+	dcr d
+x25:
+	mvi a,66
+x26:
+	mov d,h
+x27:
+	jpo x43
+x28:
+	sta 549
+x29:
+	call sub
+x30:
+	inr a
+x31:
+	sta 560
+x32:
+	inx h
+x33:
+	mvi e,166
+x34:
+	mov m,h
+x35:
+	mov h,l
+x36:
+	sta 600
+x37:
+	cmp d
+x38:
+	mvi d,86
+x39:
+	ora l
+x40:
+	cnc sub
+x41:
+	jmp x44
+x42:
+	inr d
+x43:
+	mvi b,109
+x44:
+	push psw
+	mov a,b
+	out 1
+	mov a,c
+	out 1
+	mov a,d
+	out 1
+	mov a,e
+	out 1
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	pop h
+	mov a,h
+	out 1
+	mov a,l
+	out 1
+	hlt
+sub:	inr e
+	rz
+	xra d
+	ret
@@ -2,16 +2,27 @@
 
 CC="gcc"
 FLAGS="-Wall -Wextra -Werror -pedantic-errors -Wfatal-errors"
-LIBS=""
+LIBS="-lpthread"
 SRCDIR="./src"
 BUILDDIR="./build"
 INSTALLDIR="/usr/local/bin"
 BIN="a80"
+LIB="liba80.a"
 
 case "$1" in
 	"--debug")
 		FLAGS="${FLAGS} -g -fsanitize=address,undefined"
 		;;
+	"--bench")
+		FLAGS="${FLAGS} -O2"
+		BENCH=1
+		shift
+		;;
+	"--test")
+		FLAGS="${FLAGS} -g -fsanitize=address,undefined"
+		TEST=1
+		shift
+		;;
 	"--clean")
 		rm -rv $BUILDDIR
 		exit $?
@@ -37,4 +48,17 @@ for f in $SRCDIR/*.c; do
 	echo "compiled '${f%.*}'"
 done
 $CC $FLAGS -o $BIN $BUILDDIR/*.o $LIBS
+ar rcs $BUILDDIR/$LIB $(ls $BUILDDIR/*.o | grep -v "/$BIN.o\$")
+$CC $FLAGS -I$SRCDIR -o $BUILDDIR/a80c ./client/a80c.c $BUILDDIR/$LIB $LIBS
+
 
+if [ -n "$BENCH" ]; then
+	$CC $FLAGS -I$SRCDIR -o $BUILDDIR/a80bench ./bench/bench.c $BUILDDIR/$LIB $LIBS
+	$BUILDDIR/a80bench "$@"
+fi
+
+if [ -n "$TEST" ]; then
+	$CC $FLAGS -I$SRCDIR -o $BUILDDIR/a80test ./test/test.c $BUILDDIR/$LIB $LIBS
+	$BUILDDIR/a80test "$@"
+	exit $?
+fi
@@ -1,1339 +1,787 @@
-#include <ctype.h>
 #include <errno.h>
-#include <limits.h>
+#include <getopt.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/inotify.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "a80.h"
+#include "cache.h"
+#include "emu.h"
+#include "pool.h"
+#include "server.h"
+#include "source.h"
+
+enum statsformat {
+	STATS_NONE,
+	STATS_TEXT,
+	STATS_JSON,
+};
 
-#include "list.h"
-
-#define errmsg(fmt, ...) \
-	do { \
-		fprintf(stderr, "a80 %ld: " #fmt "\n", lineno, __VA_ARGS__); \
-		exit(EXIT_FAILURE); \
-	} while(0)
-#define assertarg(args) \
-	do { \
-		if (!args) \
-			errmsg("%s", "arguments not correct for mnemonic"); \
-	} while (0)
-
-struct symtab {
-	char *label;
-	unsigned short value;
+struct job {
+	const char *path;
+	int ret;
+	size_t errline;
+	char err[128];
+	struct a80_stats stats;
+	double read;	/* seconds loading the source */
+	double write;	/* seconds writing the object file */
+	size_t hits;	/* object code taken from the cache */
 };
 
-enum immtype {
-	IMM8 = 8,
-	IMM16 = 16,
+struct batch {
+	struct job *jobs;
+	struct a80 **ctxs;
+	struct a80_image *images;
+	int onepass;
+	int full;
+	int optimize;
+	const char *cachedir;
 };
 
-static struct list *symtabs;
-static unsigned char output[65536];
-static unsigned short addr;
-static size_t noutput;
-static size_t lineno;
-static int pass;
-
-/* FORMAT [label:] [mnemonic [operand1[, operand2]]] [; comment] */
-static char *label;
-static char *mnemonic;
-static char *operand1;
-static char *operand2;
-static char *comment;
-
-static char *
-strip(char *s)
+static double
+now(void)
 {
-	if (s == NULL) return NULL;
-	if (s[0] == '\0') return "";
-
-	char *t = strchr(s, '\0') - 1;
-	while (t > s && isspace(*t)) --t;
-	t[1] = '\0';
-
-	return s + strspn(s, " \f\n\r\t\v");
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
 }
 
 static void
-parse(char *line)
+ioerror(struct job *job, const char *what)
 {
-	label = NULL;
-	mnemonic = NULL;
-	operand1 = NULL;
-	operand2 = NULL;
-	comment = NULL;
-
-	line = strip(line);
-	if (line == NULL || line[0] == '\0') return;
+	job->ret = -1;
+	job->errline = 0;
+	snprintf(job->err, sizeof(job->err), "%s: %s", what, strerror(errno));
+}
 
-	char *end = line + strlen(line);
+static void
+asmerror(struct job *job, const struct a80 *ctx)
+{
+	job->ret = -1;
+	job->errline = a80_errline(ctx);
+	snprintf(job->err, sizeof(job->err), "%s", a80_error(ctx));
+}
 
-	comment = memchr(line, ';', end - line);
-	if (comment) {
-		if (line[0] == ';') {
-			return;
+/*
+ * Assemble the source at job->path into image, unless the cache already
+ * holds its object code, in which case assembly is skipped altogether.
+ */
+static int
+assemble(struct a80 *ctx, struct a80_image *image, struct job *job,
+		const struct batch *batch)
+{
+	struct source src;
+	char key[CACHEKEYLEN + 1];
+	double start = now();
+	int ret;
+
+	/* The streaming mode only reads the whole source to hash it. */
+	if (batch->onepass && batch->cachedir == NULL) {
+		FILE *istream = fopen(job->path, "r");
+		if (istream == NULL) {
+			ioerror(job, "fopen");
+			return -1;
 		}
-
-		end = comment;
-		*end = '\0';
-		comment = strip(comment + 1);
-	}
-
-	/*
-	 * If there exists a single quote or tick in the line after the comment
-	 * has been tokenized and separated, then `operand1` consists of a
-	 * string and `operand2` is empty.
-	 *
-	 * First find the opening single quote, then the closing single quote.
-	 *
-	 * This condition exists for mnemonicuction `db`.
-	 */
-	if ((operand1 = strchr(line, '\'')) != NULL) {
-		end = operand1;
-		*end = '\0';
-		operand1 = strip(operand1 + 1);
-
-		/* Find closing single quote. */
-		end = strchr(operand1, '\'');
-		*end = '\0';
-
-		goto setmnem;
+		ret = a80_assemblestream(ctx, istream, image);
+		fclose(istream);
+		a80_stats(ctx, &job->stats);
+		if (ret != 0) {
+			asmerror(job, ctx);
+		}
+		return ret;
 	}
 
-	operand2 = memchr(line, ',', end - line);
-	if (operand2) {
-		end = operand2;
-		*end = '\0';
-		operand2 = strip(operand2 + 1);
+	if (opensource(job->path, &src) != 0) {
+		ioerror(job, "open");
+		return -1;
 	}
+	job->read = now() - start;
 
-	operand1 = strrchr(strip(line), ' ');
-	if (operand1) {
-		end = operand1;
-		*end = '\0';
-		operand1 = strip(operand1 + 1);
-	} else {
-		if ((operand1 = strrchr(strip(line), '\t')) != NULL) {
-			end = operand1;
-			*end = '\0';
-			operand1 = strip(operand1 + 1);
+	if (batch->cachedir != NULL) {
+		static const char *const modes[] = { "2", "2O", "2D", "2OD" };
+		cachekey(src.buf, src.len, batch->onepass ? "1" : modes[batch->optimize], key);
+		if (cacheload(batch->cachedir, key, image) == 0) {
+			closesource(&src);
+			job->hits = 1;
+			return 0;
 		}
 	}
-setmnem:
-	mnemonic = memchr(line, ':', end - line);
-	if (mnemonic) {
-		end = mnemonic;
-		*end = '\0';
-		mnemonic = strip(mnemonic + 1);
-
-		if (mnemonic[0] == '\0') {
-			mnemonic = NULL;
-		}
 
-		label = line;
+	if (batch->onepass) {
+		FILE *istream = fmemopen(src.buf, src.len, "r");
+		if (istream == NULL) {
+			closesource(&src);
+			ioerror(job, "fmemopen");
+			return -1;
+		}
+		ret = a80_assemblestream(ctx, istream, image);
+		fclose(istream);
 	} else {
-		mnemonic = strip(line);
+		ret = a80_assemble(ctx, src.buf, src.len, image);
 	}
-}
+	closesource(&src);
 
-static int
-cmpsym(void *symtab, void *str)
-{
-	if (symtab == NULL || str == NULL) {
-		return 0;
+	a80_stats(ctx, &job->stats);
+	if (ret != 0) {
+		asmerror(job, ctx);
+	} else if (batch->cachedir != NULL) {
+		/* Failing to fill the cache costs only a later miss. */
+		cachestore(batch->cachedir, key, image);
 	}
-	return strcmp(((struct symtab *)symtab)->label, (char *)str) == 0;
+	return ret;
 }
 
-static struct symtab *
-addsym(void)
+static void
+writeobject(const struct a80_image *image, struct job *job, const struct batch *batch)
 {
-	if (find(symtabs, label, cmpsym) != NULL) {
-		errmsg("duplicate label %s", label);
-	}
+	FILE *ostream;
+	char *path;
+	double start = now();
 
-	struct symtab *newsym = malloc(sizeof(struct symtab));
-	if (newsym == NULL) {
-		return NULL;
+	if ((path = outpath(job->path)) == NULL) {
+		ioerror(job, "malloc");
+		return;
 	}
-
-	newsym->label = label;
-	newsym->value = addr;
-
-	append(symtabs, newsym);
-
-	return newsym;
-}
-
-static void
-pass_act(unsigned short size, int outbyte)
-{
-	if (pass == 1) {
-		if (label) {
-			addsym();
-		}
-		addr += size;
+	ostream = fopen(path, "w+");
+	free(path);
+	if (ostream == NULL) {
+		ioerror(job, "fopen");
+		return;
+	}
+	if (batch->full) {
+		fwrite(image->bytes, sizeof(unsigned char), sizeof(image->bytes), ostream);
 	} else {
-		if (outbyte >= 0) {
-			output[noutput++] = (unsigned char)outbyte;
-		}
+		fwrite(image->bytes + image->lo, sizeof(unsigned char),
+				image->hi - image->lo, ostream);
 	}
+	if (fclose(ostream) != 0) {
+		ioerror(job, "fclose");
+	}
+	job->write = now() - start;
 }
 
-static unsigned short
-numcheck(char *input)
+static void
+assemblefile(struct a80 *ctx, struct a80_image *image, struct job *job,
+		const struct batch *batch)
 {
-	unsigned short num;
-	char *end = input + strlen(input) - 1;
-
-	num = *end == 'h'
-		? (unsigned short)strtol(input, &end, 16)
-		: (unsigned short)strtol(input, &end, 10);
-
-	errno = 0;
-	if ((errno == ERANGE && (num == SHRT_MAX || num == 0))
-			|| (errno != 0 && num == 0)) {
-		errmsg("%s", "unable to convert input into a number");
-	}
-
-	if (end == input) {
-		errmsg("%s", "no digits present");
+	if ((job->ret = assemble(ctx, image, job, batch)) != 0) {
+		return;
 	}
-
-	return num;
+	writeobject(image, job, batch);
 }
 
 static void
-imm(enum immtype type)
+printerror(const struct job *job, int prefixed)
 {
-	char *arg;
-	unsigned short num;
-	int found = 0;
-
-	if (strcmp(mnemonic, "lxi") == 0 || strcmp(mnemonic, "mvi") == 0) {
-		arg = operand2;
+	if (job->errline == 0) {
+		fprintf(stderr, "a80: %s: %s\n", job->path, job->err);
+	} else if (prefixed) {
+		fprintf(stderr, "a80 %s:%zu: %s\n", job->path, job->errline, job->err);
 	} else {
-		arg = operand1;
-	}
-
-	if (isdigit(arg[0])) {
-		num = numcheck(arg);
-	} else {
-		if (pass == 2) {
-			struct symtab *sym;
-			struct node *node = symtabs->head;
-
-			while (node != NULL) {
-				sym = (struct symtab *)(node->value);
-				if (sym && (strcmp(arg, sym->label) == 0)) {
-					num = sym->value;
-					found = 1;
-					break;
-				}
-				node = node->next;
-			}
-
-			if (!found) {
-				errmsg("label %s undefined", arg);
-			}
-		}
-	}
-
-	if (pass == 2) {
-		output[noutput++] = (unsigned char)(num & 0xff);
-		if (type == IMM16) {
-			output[noutput++] = (unsigned char)((num >> 8) & 0xff);
-		}
+		fprintf(stderr, "a80 %zu: %s\n", job->errline, job->err);
 	}
 }
 
+/* Reassemble the source of job and write its object file. */
 static void
-a16(void)
+rebuild(struct a80 *ctx, struct a80_image *image, struct job *job,
+		const struct batch *batch)
 {
-	unsigned short num;
-	int found = 0;
+	struct source src;
+	double start = now();
 
-	if (isdigit(operand1[0])) {
-		num = numcheck(operand1);
+	job->ret = 0;
+	if (opensource(job->path, &src) != 0) {
+		ioerror(job, "open");
 	} else {
-		struct symtab *sym;
-		struct node *node = symtabs->head;
-
-		while (node != NULL) {
-			sym = (struct symtab *)(node->value);
-			if (sym && (strcmp(operand1, sym->label) == 0)) {
-				num = sym->value;
-				found = 1;
-				break;
-			}
-			node = node->next;
-		}
-
-		if (!found) {
-			errmsg("label %s undefined", operand1);
+		int ret = a80_reassemble(ctx, src.buf, src.len, image);
+		closesource(&src);
+		if (ret != 0) {
+			asmerror(job, ctx);
+		} else {
+			writeobject(image, job, batch);
 		}
 	}
 
-	if (pass == 2) {
-		output[noutput++] = (unsigned char)(num & 0xff);
-		output[noutput++] = (unsigned char)((num >> 8) & 0xff);
+	if (job->ret != 0) {
+		printerror(job, 0);
+	} else {
+		fprintf(stderr, "a80: %s: assembled in %.3f ms\n",
+				job->path, (now() - start) * 1e3);
 	}
 }
 
+/*
+ * Assemble the source of job, then again whenever it is written or replaced.
+ * Its directory is watched rather than the file itself so that editors that
+ * save by renaming a new file over the old are noticed too. The source stays
+ * resident in ctx, so each revision lexes only the lines that changed.
+ */
 static int
-reg_mod8(char *reg)
-{
-	switch (reg[0]) {
-	case 'b':
-		return 0x00;
-	case 'c':
-		return 0x01;
-	case 'd':
-		return 0x02;
-	case 'e':
-		return 0x03;
-	case 'h':
-		return 0x04;
-	case 'l':
-		return 0x05;
-	case 'm':
-		return 0x06;
-	case 'a':
-		return 0x07;
-	default:
-		errmsg("invalid register %s", reg);
+watch(struct a80 *ctx, struct a80_image *image, struct job *job,
+		const struct batch *batch)
+{
+	_Alignas(struct inotify_event) char events[4096];
+	const char *slash = strrchr(job->path, '/');
+	const char *name = slash ? slash + 1 : job->path;
+	char *dir = slash ? strndup(job->path, slash == job->path ? 1 : slash - job->path)
+		: strdup(".");
+	int fd = inotify_init1(IN_CLOEXEC);
+
+	if (dir == NULL || fd < 0 || inotify_add_watch(fd, dir, IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+		perror(job->path);
+		free(dir);
+		return -1;
+	}
+	free(dir);
+
+	for (;;) {
+		int changed = 0;
+
+		rebuild(ctx, image, job, batch);
+		while (!changed) {
+			ssize_t n = read(fd, events, sizeof(events));
+			if (n < 0 && errno == EINTR) {
+				continue;
+			}
+			if (n <= 0) {
+				perror("inotify");
+				close(fd);
+				return -1;
+			}
+			for (char *p = events; p < events + n; ) {
+				struct inotify_event *ev = (struct inotify_event *)p;
+				if (ev->len > 0 && strcmp(ev->name, name) == 0) {
+					changed = 1;
+				}
+				p += sizeof(*ev) + ev->len;
+			}
+		}
 	}
 }
 
+/*
+ * Assemble the source of job and run its object code on an emulated 8080,
+ * whose in and out read and write the standard streams of a80.
+ */
 static int
-reg_mod16(void)
+runfile(struct a80 *ctx, struct a80_image *image, struct job *job,
+		const struct batch *batch, enum statsformat stats)
 {
-	if (strcmp(operand1, "b") == 0) {
-		return 0x00;
-	} else if (strcmp(operand1, "d") == 0) {
-		return 0x10;
-	} else if (strcmp(operand1, "h") == 0) {
-		return 0x20;
-	} else if (strcmp(operand1, "psw") == 0) {
-		if (strcmp(mnemonic, "pop") == 0
-				|| strcmp(mnemonic, "push") == 0) {
-			return 0x30;
-		} else {
-			errmsg("psw may not be used with %s", mnemonic);
-		}
-	} else if (strcmp(operand1, "sp") == 0) {
-		if (strcmp(mnemonic, "pop") != 0
-				|| strcmp(mnemonic, "push") != 0) {
-			return 0x30;
-		} else {
-			errmsg("sp may not be used with %s", mnemonic);
-		}
-	} else {
-		errmsg("invalid register for mnemonicuction %s", mnemonic);
-	}
-}
+	struct cpu *cpu;
+	int ret = 0;
 
-static unsigned short
-dollar(void)
-{
-	unsigned short num = addr;
-
-	if (strlen(operand1) > 1) {
-		if (operand1[1] == '+') {
-			num += numcheck(operand1 + 2);
-		} else if (operand1[1] == '-') {
-			num -= numcheck(operand1 + 2);
-		} else if (operand1[1] == '*') {
-			num *= numcheck(operand1 + 2);
-		} else if (operand1[1] == '/') {
-			num /= numcheck(operand1 + 2);
-		} else if (operand1[1] == '%') {
-			num %= numcheck(operand1 + 2);
-		} else {
-			errmsg("%s", "invalid operator in equ");
-		}
+	if ((job->ret = assemble(ctx, image, job, batch)) != 0) {
+		printerror(job, 0);
+		return -1;
+	}
+	if ((cpu = malloc(sizeof(*cpu))) == NULL) {
+		perror("malloc");
+		return -1;
 	}
 
-	return num;
-}
-
-static void
-nop(void)
-{
-	assertarg(!operand1 && !operand2);
-	pass_act(1, 0x00);
-}
-
-static void
-mov(void)
-{
-	assertarg(operand1 && operand2);
-	pass_act(1, 0x40 + (reg_mod8(operand1) << 3) + reg_mod8(operand2));
-}
-
-static void
-hlt(void)
-{
-	assertarg(!operand1 && !operand2);
-	pass_act(1, 0x76);
-}
-
-static void
-add(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(1, 0x80 + reg_mod8(operand1));
-}
-
-static void
-adc(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(1, 0x88 + reg_mod8(operand1));
-}
-
-static void
-sub(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(1, 0x90 + reg_mod8(operand1));
-}
-
-static void
-sbb(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(1, 0x98 + reg_mod8(operand1));
-}
-
-static void
-ana(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(1, 0xa0 + reg_mod8(operand1));
-}
-
-static void
-xra(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(1, 0xa8 + reg_mod8(operand1));
-}
-
-static void
-ora(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(1, 0xb0 + reg_mod8(operand1));
-}
-
-static void
-cmp(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(1, 0xb8 + reg_mod8(operand1));
-}
-
-static void
-adi(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(2, 0xc6);
-	imm(IMM8);
-}
-
-static void
-aci(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(2, 0xce);
-	imm(IMM8);
-}
-
-static void
-sui(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(2, 0xd6);
-	imm(IMM8);
-}
-
-static void
-sbi(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(2, 0xde);
-	imm(IMM8);
-}
-
-static void
-ani(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(2, 0xe6);
-	imm(IMM8);
-}
-
-static void
-xri(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(2, 0xee);
-	imm(IMM8);
-}
-
-static void
-ori(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(2, 0xf6);
-	imm(IMM8);
-}
-
-static void
-cpi(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(2, 0xfe);
-	imm(IMM8);
-}
-
-static void
-xthl(void)
-{
-	assertarg(!operand1 && !operand2);
-	pass_act(1, 0xe3);
-}
-
-static void
-pchl(void)
-{
-	assertarg(!operand1 && !operand2);
-	pass_act(1, 0xe9);
-}
-
-static void
-xchg(void)
-{
-	assertarg(!operand1 && !operand2);
-	pass_act(1, 0xeb);
-}
-
-static void
-sphl(void)
-{
-	assertarg(!operand1 && !operand2);
-	pass_act(1, 0xf9);
-}
-
-static void
-push(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(1, 0xc5 + reg_mod16());
-}
-
-static void
-pop(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(1, 0xc1 + reg_mod16());
-}
-
-static void
-out(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(2, 0xd3);
-	imm(IMM8);
-}
-
-static void
-in(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(2, 0xdb);
-	imm(IMM8);
-}
-
-static void
-di(void)
-{
-	assertarg(!operand1 && !operand2);
-	pass_act(1, 0xf3);
-}
-
-static void
-ei(void)
-{
-	assertarg(!operand1 && !operand2);
-	pass_act(1, 0xfb);
-}
-
-static void
-rnz(void)
-{
-	assertarg(!operand1 && !operand2);
-	pass_act(1, 0xc0);
-}
-
-static void
-jnz(void)
-{
-	assertarg(!operand1 && !operand2);
-	pass_act(3, 0xc2);
-	a16();
-}
-
-static void
-jmp(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(3, 0xc3);
-	a16();
-}
-
-static void
-cnz(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(3, 0xc4);
-	a16();
-}
-
-static void
-rz(void)
-{
-	assertarg(!operand1 && !operand2);
-	pass_act(1, 0xc8);
-}
-
-static void
-ret(void)
-{
-	assertarg(!operand1 && !operand2);
-	pass_act(1, 0xc9);
-}
-
-static void
-jz(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(3, 0xca);
-	a16();
-}
-
-static void
-cz(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(3, 0xcc);
-	a16();
-}
-
-static void
-call(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(3, 0xcd);
-	a16();
-}
-
-static void
-rnc(void)
-{
-	assertarg(!operand1 && !operand2);
-	pass_act(1, 0xd0);
-}
-
-static void
-jnc(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(3, 0xd2);
-	a16();
-}
-
-static void
-cnc(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(3, 0xd4);
-	a16();
-}
-
-static void
-rc(void)
-{
-	assertarg(!operand1 && !operand2);
-	pass_act(1, 0xd8);
-}
-
-static void
-jc(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(1, 0xda);
-	a16();
-}
-
-static void
-cc(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(3, 0xdc);
-	a16();
-}
-
-static void
-rpo(void)
-{
-	assertarg(!operand1 && !operand2);
-	pass_act(1, 0xe0);
-}
-
-static void
-jpo(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(3, 0xe2);
-	a16();
-}
-
-static void
-cpo(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(3, 0xe4);
-	a16();
-}
-
-static void
-rpe(void)
-{
-	assertarg(!operand1 && !operand2);
-	pass_act(1, 0xe8);
-}
-
-static void
-jpe(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(3, 0xea);
-	a16();
-}
-
-static void
-cpe(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(3, 0xec);
-	a16();
-}
-
-static void
-rp(void)
-{
-	assertarg(!operand1 && !operand2);
-	pass_act(1, 0xf0);
-}
+	cpuinit(cpu, image, stdin, stdout);
+	double start = now();
+	enum cpustop stop = cpurun(cpu, 0);
+	double elapsed = now() - start;
+	fflush(stdout);
 
-static void
-jp(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(3, 0xf2);
-	a16();
-}
+	if (stop == CPU_UNDEFINED) {
+		fprintf(stderr, "a80: %s: undefined opcode 0x%02x at 0x%04x\n",
+				job->path, cpu->mem[cpu->pc], cpu->pc);
+		ret = -1;
+	}
 
-static void
-cp(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(3, 0xf4);
-	a16();
-}
+	double mips = elapsed > 0 ? cpu->steps / elapsed / 1e6 : 0;
+	if (stats == STATS_JSON) {
+		fprintf(stderr, "{\"run\": %.6f, \"steps\": %llu, \"mips\": %.3f, "
+				"\"translated\": %llu, \"invalidated\": %llu}\n",
+				elapsed, cpu->steps, mips, cpu->translated, cpu->invalidated);
+	} else if (stats == STATS_TEXT) {
+		fprintf(stderr, "run: %.3f ms\n", elapsed * 1e3);
+		fprintf(stderr, "steps: %llu\n", cpu->steps);
+		fprintf(stderr, "mips: %.2f\n", mips);
+		fprintf(stderr, "translated: %llu\n", cpu->translated);
+		fprintf(stderr, "invalidated: %llu\n", cpu->invalidated);
+	}
 
-static void
-rm(void)
-{
-	assertarg(!operand1 && !operand2);
-	pass_act(1, 0xf8);
+	free(cpu);
+	return ret;
 }
 
-static void
-jm(void)
+/*
+ * Store the least and most T-states line takes in *lo and *hi, returning 0
+ * if it encodes no instruction.
+ */
+static int
+tstates(const struct a80_line *line, unsigned long *lo, unsigned long *hi)
 {
-	assertarg(operand1 && !operand2);
-	pass_act(3, 0xfa);
-	a16();
-}
+	struct a80_insn insn;
 
-static void
-cm(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(3, 0xfc);
-	a16();
+	if (line->opcode < 0 || a80_decode((unsigned char)line->opcode, &insn) != 0) {
+		return 0;
+	}
+	*lo = insn.untaken;
+	*hi = insn.cycles;
+	return 1;
 }
 
 static void
-rst(void)
+printcost(const char *what, unsigned long lo, unsigned long hi)
 {
-	assertarg(operand1 && !operand2);
-
-	int offset = (int)strtol(operand1, (char **)NULL, 10);
-	if (offset >= 0 && offset <= 7) {
-		pass_act(1, 0xc7 + (offset << 3));
+	if (lo == hi) {
+		printf("%12s; %s: %lu T-states\n", "", what, hi);
 	} else {
-		errmsg("invalid reset vector %s", operand1);
+		printf("%12s; %s: %lu-%lu T-states\n", "", what, lo, hi);
 	}
 }
 
+/*
+ * Print the loop that line i closes, if it jumps back to a label in the
+ * straight run of lines before it, with the T-states of one pass around it.
+ */
 static void
-rlc(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(1, 0x07);
-}
-
-static void
-rrc(void)
-{
-	assertarg(!operand1 && !operand2);
-	pass_act(1, 0x0f);
-}
-
-static void
-ral(void)
-{
-	assertarg(!operand1 && !operand2);
-	pass_act(1, 0x17);
-}
-
-static void
-rar(void)
-{
-	assertarg(!operand1 && !operand2);
-	pass_act(1, 0x1f);
-}
-
-static void
-daa(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(1, 0x27);
-}
-
-static void
-cma(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(1, 0x2f);
-}
-
-static void
-stc(void)
-{
-	assertarg(!operand1 && !operand2);
-	pass_act(1, 0x37);
-}
-
-static void
-cmc(void)
+printloop(const struct a80_line *lines, size_t i)
 {
-	assertarg(operand1 && !operand2);
-	pass_act(1, 0x3f);
-}
+	const struct a80_line *jump = &lines[i];
+	const char *label = NULL;
+	unsigned long lo = 0, hi = 0, l, h;
+	char what[64];
 
-static void
-inx(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(1, 0x03 + reg_mod16());
-}
-
-static void
-dad(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(1, 0x09 + reg_mod16());
-}
-
-static void
-dcx(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(1, 0x0b + reg_mod16());
-}
-
-static void
-inr(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(1, 0x04 + (reg_mod8(operand1) << 3));
-}
-
-static void
-dcr(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(1, 0x05 + (reg_mod8(operand1) << 3));
-}
-
-static void
-stax(void)
-{
-	assertarg(operand1 && !operand2);
-
-	switch (operand1[0]) {
-	case 'b':
-		pass_act(1, 0x02);
-		break;
-	case 'd':
-		pass_act(1, 0x12);
-		break;
-	default:
-		errmsg("%s", "stax operates on registers b and d");
+	if (jump->opcode != 0xc3 && (jump->opcode & 0xc7) != 0xc2) {
+		return;
 	}
-}
-
-static void
-ldax(void)
-{
-	assertarg(operand1 && !operand2);
-
-	switch (operand1[0]) {
-	case 'b':
-		pass_act(1, 0x0a);
-		break;
-	case 'd':
-		pass_act(1, 0x1a);
-		break;
-	default:
-		errmsg("%s", "ladax operates on registers b and d");
+	if (jump->operand < 0 || jump->operand > jump->addr) {
+		return;
+	}
+	for (size_t j = i + 1; j-- > 0 && lines[j].addr >= jump->operand; ) {
+		if (j < i && lines[j].addr + lines[j].size != lines[j + 1].addr) {
+			return;
+		}
+		if (tstates(&lines[j], &l, &h)) {
+			lo += l;
+			hi += h;
+		}
+		if (label == NULL && lines[j].addr == jump->operand && lines[j].label) {
+			label = lines[j].label;
+		}
+	}
+	if (label == NULL) {
+		return;
 	}
-}
-
-static void
-shld(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(3, 0x22);
-	a16();
-}
-
-static void
-lhld(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(3, 0x2a);
-	a16();
-}
-
-static void
-sta(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(3, 0x32);
-	a16();
-}
 
-static void
-lda(void)
-{
-	assertarg(operand1 && !operand2);
-	pass_act(3, 0x3a);
-	a16();
+	snprintf(what, sizeof(what), "loop %s, per pass", label);
+	printcost(what, lo, hi);
 }
 
-static void
-mvi(void)
-{
-	assertarg(operand1 && operand2);
-	pass_act(2, 0x06 + (reg_mod8(operand1) << 3));
-	imm(IMM8);
-}
+/*
+ * Assemble the source of job and write its object file, then print the
+ * source to stdout with the address and T-states of each line, the total
+ * of each block of lines from one label to the next, and the T-states of
+ * each loop that a jump back to an earlier label closes. A conditional
+ * call or return is given as the T-states when its condition fails and
+ * when it holds.
+ */
+static int
+listfile(struct a80 *ctx, struct a80_image *image, struct job *job,
+		const struct batch *batch)
+{
+	struct source src;
+	struct a80_line *lines = NULL;
+	const char *block = NULL;
+	unsigned long lo = 0, hi = 0, l, h;
+
+	job->ret = 0;
+	if (opensource(job->path, &src) != 0) {
+		ioerror(job, "open");
+		printerror(job, 0);
+		return -1;
+	}
+	if (a80_reassemble(ctx, src.buf, src.len, image) != 0) {
+		asmerror(job, ctx);
+	} else {
+		writeobject(image, job, batch);
+	}
+	size_t n = a80_nlines(ctx);
+	if (job->ret == 0 && n > 0 && (lines = malloc(n * sizeof(*lines))) == NULL) {
+		ioerror(job, "malloc");
+	}
+	if (job->ret != 0) {
+		closesource(&src);
+		printerror(job, 0);
+		return -1;
+	}
 
-static void
-lxi(void)
-{
-	assertarg(operand1 && operand2);
-	pass_act(3, 0x01 + reg_mod16());
-	imm(IMM16);
-}
+	for (size_t i = 0; i < n; ++i) {
+		a80_line(ctx, i, &lines[i]);
+	}
+	for (size_t i = 0; i < n; ++i) {
+		const struct a80_line *line = &lines[i];
+		const char *s = src.buf + line->offset;
+		const char *nl = memchr(s, '\n', src.len - line->offset);
+		int len = (int)(nl ? nl - s : src.buf + src.len - s);
+		char cost[16] = "";
 
-static void
-name(void)
-{
-	assertarg(!label && operand1 && !operand2);
-}
+		if (line->label) {
+			if (block && hi > 0) {
+				printcost(block, lo, hi);
+			}
+			block = line->label;
+			lo = hi = 0;
+		}
+		if (tstates(line, &l, &h)) {
+			snprintf(cost, sizeof(cost), l == h ? "%lu" : "%lu/%lu", l, h);
+			lo += l;
+			hi += h;
+		}
+		if (cost[0] || line->label) {
+			printf("%04x %6s  %.*s\n", line->addr, cost, len, s);
+		} else {
+			printf("%11s  %.*s\n", "", len, s);
+		}
+		printloop(lines, i);
+	}
+	if (block && hi > 0) {
+		printcost(block, lo, hi);
+	}
 
-static void
-title(void)
-{
-	assertarg(!label && operand1 && !operand2);
+	free(lines);
+	closesource(&src);
+	return 0;
 }
 
 static void
-end(void)
+runjob(void *arg, size_t worker, size_t i)
 {
-	assertarg(!label && !operand1 && !operand2);
+	struct batch *batch = arg;
+	assemblefile(batch->ctxs[worker], &batch->images[worker],
+			&batch->jobs[i], batch);
 }
 
-static void
-org(void)
+/* Append the paths listed one per line in the file at listpath. */
+static int
+readlist(const char *listpath, const char ***paths, size_t *npaths)
 {
-	assertarg(!label && operand1 && !operand2);
+	struct source src;
 
-	if (isdigit(operand1[0])) {
-		if (pass == 1) {
-			addr = numcheck(operand1);
-		}
-	} else {
-		errmsg("%s", "org requires a number");
+	if (opensource(listpath, &src) != 0) {
+		return -1;
 	}
-}
 
-static void
-equ(void)
-{
-	unsigned short value;
+	const char *line = src.buf, *end = src.buf + src.len;
+	while (line < end) {
+		const char *nl = memchr(line, '\n', end - line);
+		const char *eol = nl ? nl : end;
 
-	if (!label) {
-		errmsg("%s", "equ statement requires a label");
-	}
+		if (eol > line) {
+			char *path = malloc(eol - line + 1);
+			const char **p = realloc(*paths, (*npaths + 1) * sizeof(char *));
+			if (path == NULL || p == NULL) {
+				free(path);
+				closesource(&src);
+				return -1;
+			}
+			memcpy(path, line, eol - line);
+			path[eol - line] = '\0';
+			*paths = p;
+			(*paths)[(*npaths)++] = path;
+		}
 
-	if (operand1[0] == '$') {
-		value = dollar();
-	} else {
-		value = numcheck(operand1);
+		line = eol + 1;
 	}
 
-	if (pass == 1) {
-		unsigned short tmp = addr;
-		addr = value;
-		addsym();
-		addr = tmp;
-	}
+	closesource(&src);
+	return 0;
 }
 
+/*
+ * Report the totals of every job to stderr. Times are summed across jobs,
+ * so they exceed the wall time of a parallel batch.
+ */
 static void
-dw(void)
+printstats(enum statsformat format, struct job *total)
 {
-	assertarg(operand1 && !operand2);
+	struct a80_stats *stats = &total->stats;
+	struct rusage usage;
+	long maxrss = 0;
 
-	if (pass == 1) {
-		if (label) {
-			addsym();
-		}
+	if (getrusage(RUSAGE_SELF, &usage) == 0) {
+		maxrss = usage.ru_maxrss;
 	}
-	a16();
 
-	addr += 2;
-}
-
-static void
-ds(void)
-{
-	assertarg(operand1 && !operand2);
-
-	if (pass == 1) {
-		if (label) {
-			addsym();
-		}
-	} else {
-		unsigned short num = numcheck(operand1);
-		for (size_t i = 0; i < num; ++i) {
-			output[++noutput] = 0;
-		}
+	if (format == STATS_JSON) {
+		fprintf(stderr, "{\"read\": %.6f, \"pass1\": %.6f, \"pass2\": %.6f, "
+				"\"write\": %.6f, \"lines\": %zu, \"symbols\": %zu, "
+				"\"lookups\": %zu, \"probes\": %zu, \"memolookups\": %zu, "
+				"\"recalled\": %zu, \"dispatches\": %zu, "
+				"\"emitted\": %zu, \"peepholes\": %zu, \"savedbytes\": %zu, "
+				"\"savedtstates\": %zu, \"pruned\": %zu, \"prunedbytes\": %zu, "
+				"\"allocations\": %zu, \"mallocs\": %zu, "
+				"\"bytes\": %zu, \"peak\": %zu, \"maxrss\": %ld, "
+				"\"hits\": %zu}\n",
+				total->read, stats->pass1, stats->pass2, total->write,
+				stats->lines, stats->symbols, stats->lookups, stats->probes,
+				stats->memolookups, stats->recalled,
+				stats->dispatches, stats->emitted, stats->peepholes,
+				stats->savedbytes, stats->savedtstates, stats->pruned,
+				stats->prunedbytes, stats->allocations,
+				stats->mallocs, stats->bytes, stats->peak, maxrss,
+				total->hits);
+		return;
 	}
 
-	addr += numcheck(operand1);
+	fprintf(stderr, "read: %.3f ms\n", total->read * 1e3);
+	fprintf(stderr, "pass1: %.3f ms\n", stats->pass1 * 1e3);
+	fprintf(stderr, "pass2: %.3f ms\n", stats->pass2 * 1e3);
+	fprintf(stderr, "write: %.3f ms\n", total->write * 1e3);
+	fprintf(stderr, "lines: %zu\n", stats->lines);
+	fprintf(stderr, "symbols: %zu\n", stats->symbols);
+	fprintf(stderr, "lookups: %zu\n", stats->lookups);
+	fprintf(stderr, "probes: %zu\n", stats->probes);
+	fprintf(stderr, "recalled: %zu of %zu (%.1f%%)\n", stats->recalled,
+			stats->memolookups, stats->memolookups
+			? 100.0 * stats->recalled / stats->memolookups : 0.0);
+	fprintf(stderr, "dispatches: %zu\n", stats->dispatches);
+	fprintf(stderr, "emitted: %zu\n", stats->emitted);
+	fprintf(stderr, "peepholes: %zu (%zu bytes, %zu T-states saved)\n",
+			stats->peepholes, stats->savedbytes, stats->savedtstates);
+	fprintf(stderr, "pruned: %zu blocks (%zu bytes)\n", stats->pruned,
+			stats->prunedbytes);
+	fprintf(stderr, "allocations: %zu\n", stats->allocations);
+	fprintf(stderr, "mallocs: %zu\n", stats->mallocs);
+	fprintf(stderr, "bytes: %zu\n", stats->bytes);
+	fprintf(stderr, "peak: %zu\n", stats->peak);
+	fprintf(stderr, "maxrss: %ld KB\n", maxrss);
+	fprintf(stderr, "hits: %zu\n", total->hits);
+}
+
+static void
+usage(char *argv0)
+{
+	fprintf(stderr, "usage: %s [-1DOftw] [-c cachedir] [-j jobs] [-l list] [-p threads] "
+			"[--stats[=json]] <file.asm>...\n       %s run [-1] [--stats[=json]] <file.asm>\n"
+			"       %s [-j workers] --serve[=socket]\n", argv0, argv0, argv0);
+	exit(EXIT_FAILURE);
 }
 
-static void
-db(void)
+int
+main(int argc, char *argv[])
 {
-	assertarg(operand1 && !operand2);
-
-	if (isdigit(operand1[0])) {
-		pass_act(1, numcheck(operand1));
-	} else {
-		if (pass == 1) {
-			if (label) {
-				addsym();
+	const char **paths = NULL;
+	size_t npaths = 0;
+	size_t njobs = 0;
+	size_t nthreads = 1;
+	int opt;
+	int onepass = 0;
+	int optimize = 0;
+	int full = 0;
+	int watching = 0;
+	int running = 0;
+	int listing = 0;
+	const char *sockpath = NULL;
+	const char *cachedir = NULL;
+	enum statsformat stats = STATS_NONE;
+	int status = EXIT_SUCCESS;
+
+	static const struct option longopts[] = {
+		{ "serve", optional_argument, NULL, 'S' },
+		{ "stats", optional_argument, NULL, 's' },
+		{ NULL, 0, NULL, 0 },
+	};
+
+	/* a80 run runs the object code of a source rather than writing it. */
+	if (argc > 1 && strcmp(argv[1], "run") == 0) {
+		running = 1;
+		argv[1] = argv[0];
+		--argc;
+		++argv;
+	}
+
+	while ((opt = getopt_long(argc, argv, "1DOc:fj:l:p:tw", longopts, NULL)) != -1) {
+		switch (opt) {
+		case '1':
+			onepass = 1;
+			break;
+		case 'D':
+			optimize |= A80_PRUNE;
+			break;
+		case 'O':
+			optimize |= A80_PEEPHOLE;
+			break;
+		case 'c':
+			cachedir = optarg;
+			if (mkdir(cachedir, 0777) != 0 && errno != EEXIST) {
+				perror(cachedir);
+				exit(EXIT_FAILURE);
 			}
-		} else {
-			for (char *c = operand1; *c != '\0'; ++c) {
-				output[noutput++] = (unsigned char)*c;
+			break;
+		case 'f':
+			full = 1;
+			break;
+		case 'j':
+			if ((njobs = strtoul(optarg, NULL, 10)) == 0) {
+				usage(argv[0]);
+			}
+			break;
+		case 'l':
+			if (readlist(optarg, &paths, &npaths) != 0) {
+				perror(optarg);
+				exit(EXIT_FAILURE);
+			}
+			break;
+		case 'p':
+			if ((nthreads = strtoul(optarg, NULL, 10)) == 0) {
+				usage(argv[0]);
+			}
+			break;
+		case 't':
+			listing = 1;
+			break;
+		case 'w':
+			watching = 1;
+			break;
+		case 'S':
+			sockpath = optarg ? optarg : serverpath();
+			break;
+		case 's':
+			if (optarg == NULL) {
+				stats = STATS_TEXT;
+			} else if (strcmp(optarg, "json") == 0) {
+				stats = STATS_JSON;
+			} else {
+				usage(argv[0]);
 			}
+			break;
+		default:
+			usage(argv[0]);
 		}
-		addr += strlen(operand1);
-	}
-}
-
-static void
-process(void)
-{
-	if (!mnemonic && !operand1 && !operand2) {
-		pass_act(0, -1);
-		return;
 	}
-
-	if (strcmp(mnemonic, "nop") == 0) {
-		nop();
-	} else if (strcmp(mnemonic, "mov") == 0) {
-		mov();
-	} else if (strcmp(mnemonic, "hlt") == 0) {
-		hlt();
-	} else if (strcmp(mnemonic, "add") == 0) {
-		add();
-	} else if (strcmp(mnemonic, "adc") == 0) {
-		adc();
-	} else if (strcmp(mnemonic, "sub") == 0) {
-		sub();
-	} else if (strcmp(mnemonic, "sbb") == 0) {
-		sbb();
-	} else if (strcmp(mnemonic, "ana") == 0) {
-		ana();
-	} else if (strcmp(mnemonic, "xra") == 0) {
-		xra();
-	} else if (strcmp(mnemonic, "ora") == 0) {
-		ora();
-	} else if (strcmp(mnemonic, "cmp") == 0) {
-		cmp();
-	} else if (strcmp(mnemonic, "adi") == 0) {
-		adi();
-	} else if (strcmp(mnemonic, "aci") == 0) {
-		aci();
-	} else if (strcmp(mnemonic, "sui") == 0) {
-		sui();
-	} else if (strcmp(mnemonic, "sbi") == 0) {
-		sbi();
-	} else if (strcmp(mnemonic, "ani") == 0) {
-		ani();
-	} else if (strcmp(mnemonic, "xri") == 0) {
-		xri();
-	} else if (strcmp(mnemonic, "ori") == 0) {
-		ori();
-	} else if (strcmp(mnemonic, "cpi") == 0) {
-		cpi();
-	} else if (strcmp(mnemonic, "xthl") == 0) {
-		xthl();
-	} else if (strcmp(mnemonic, "pchl") == 0) {
-		pchl();
-	} else if (strcmp(mnemonic, "xchg") == 0) {
-		xchg();
-	} else if (strcmp(mnemonic, "sphl") == 0) {
-		sphl();
-	} else if (strcmp(mnemonic, "push") == 0) {
-		push();
-	} else if (strcmp(mnemonic, "pop") == 0) {
-		pop();
-	} else if (strcmp(mnemonic, "out") == 0) {
-		out();
-	} else if (strcmp(mnemonic, "in") == 0) {
-		in();
-	} else if (strcmp(mnemonic, "di") == 0) {
-		di();
-	} else if (strcmp(mnemonic, "ei") == 0) {
-		ei();
-	} else if (strcmp(mnemonic, "rnz") == 0) {
-		rnz();
-	} else if (strcmp(mnemonic, "jnz") == 0) {
-		jnz();
-	} else if (strcmp(mnemonic, "jmp") == 0) {
-		jmp();
-	} else if (strcmp(mnemonic, "cnz") == 0) {
-		cnz();
-	} else if (strcmp(mnemonic, "rz") == 0) {
-		rz();
-	} else if (strcmp(mnemonic, "ret") == 0) {
-		ret();
-	} else if (strcmp(mnemonic, "jz") == 0) {
-		jz();
-	} else if (strcmp(mnemonic, "cz") == 0) {
-		cz();
-	} else if (strcmp(mnemonic, "call") == 0) {
-		call();
-	} else if (strcmp(mnemonic, "rnc") == 0) {
-		rnc();
-	} else if (strcmp(mnemonic, "jnc") == 0) {
-		jnc();
-	} else if (strcmp(mnemonic, "cnc") == 0) {
-		cnc();
-	} else if (strcmp(mnemonic, "rc") == 0) {
-		rc();
-	} else if (strcmp(mnemonic, "jc") == 0) {
-		jc();
-	} else if (strcmp(mnemonic, "cc") == 0) {
-		cc();
-	} else if (strcmp(mnemonic, "rpo") == 0) {
-		rpo();
-	} else if (strcmp(mnemonic, "jpo") == 0) {
-		jpo();
-	} else if (strcmp(mnemonic, "cpo") == 0) {
-		cpo();
-	} else if (strcmp(mnemonic, "rpe") == 0) {
-		rpe();
-	} else if (strcmp(mnemonic, "jpe") == 0) {
-		jpe();
-	} else if (strcmp(mnemonic, "cpe") == 0) {
-		cpe();
-	} else if (strcmp(mnemonic, "rp") == 0) {
-		rp();
-	} else if (strcmp(mnemonic, "jp") == 0) {
-		jp();
-	} else if (strcmp(mnemonic, "cp") == 0) {
-		cp();
-	} else if (strcmp(mnemonic, "rm") == 0) {
-		rm();
-	} else if (strcmp(mnemonic, "jm") == 0) {
-		jm();
-	} else if (strcmp(mnemonic, "cm") == 0) {
-		cm();
-	} else if (strcmp(mnemonic, "rst") == 0) {
-		rst();
-	} else if (strcmp(mnemonic, "rlc") == 0) {
-		rlc();
-	} else if (strcmp(mnemonic, "rrc") == 0) {
-		rrc();
-	} else if (strcmp(mnemonic, "ral") == 0) {
-		ral();
-	} else if (strcmp(mnemonic, "rar") == 0) {
-		rar();
-	} else if (strcmp(mnemonic, "daa") == 0) {
-		daa();
-	} else if (strcmp(mnemonic, "cma") == 0) {
-		cma();
-	} else if (strcmp(mnemonic, "stc") == 0) {
-		stc();
-	} else if (strcmp(mnemonic, "cmc") == 0) {
-		cmc();
-	} else if (strcmp(mnemonic, "inx") == 0) {
-		inx();
-	} else if (strcmp(mnemonic, "dad") == 0) {
-		dad();
-	} else if (strcmp(mnemonic, "dcx") == 0) {
-		dcx();
-	} else if (strcmp(mnemonic, "inr") == 0) {
-		inr();
-	} else if (strcmp(mnemonic, "dcr") == 0) {
-		dcr();
-	} else if (strcmp(mnemonic, "stax") == 0) {
-		stax();
-	} else if (strcmp(mnemonic, "ldax") == 0) {
-		ldax();
-	} else if (strcmp(mnemonic, "shld") == 0) {
-		shld();
-	} else if (strcmp(mnemonic, "lhld") == 0) {
-		lhld();
-	} else if (strcmp(mnemonic, "sta") == 0) {
-		sta();
-	} else if (strcmp(mnemonic, "lda") == 0) {
-		lda();
-	} else if (strcmp(mnemonic, "mvi") == 0) {
-		mvi();
-	} else if (strcmp(mnemonic, "lxi") == 0) {
-		lxi();
-	} else if (strcmp(mnemonic, "name") == 0) {
-		name();
-	} else if (strcmp(mnemonic, "title") == 0) {
-		title();
-	} else if (strcmp(mnemonic, "end") == 0) {
-		end();
-	} else if (strcmp(mnemonic, "org") == 0) {
-		org();
-	} else if (strcmp(mnemonic, "equ") == 0) {
-		equ();
-	} else if (strcmp(mnemonic, "dw") == 0) {
-		dw();
-	} else if (strcmp(mnemonic, "ds") == 0) {
-		ds();
-	} else if (strcmp(mnemonic, "db") == 0) {
-		db();
-	} else {
-		errmsg("unknown mnemonic: %s", mnemonic);
+	if (sockpath != NULL) {
+		long ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+		/* Returns only if the socket cannot be served. */
+		serve(sockpath, njobs ? njobs : ncpus > 0 ? (size_t)ncpus : 1);
+		perror(sockpath);
+		exit(EXIT_FAILURE);
 	}
-}
-
-static void
-assemble(struct list *lines)
-{
-	struct node *line;
-
-	/*
-	 * parse() directly modifies the list. Therefore, copy the original
-	 * list for the second pass.
-	 */
-	struct list *linesdup = initlist();
-	for (line = lines->head; line != NULL; line = line->next) {
-		if (line->value != NULL) {
-			append(linesdup, strdup((char *)line->value));
+	for (int i = optind; i < argc; ++i) {
+		const char **p = realloc(paths, (npaths + 1) * sizeof(char *));
+		if (p == NULL) {
+			perror("malloc");
+			exit(EXIT_FAILURE);
 		}
+		paths = p;
+		paths[npaths++] = argv[i];
+	}
+	if (npaths == 0 || (watching && (npaths > 1 || onepass))
+			|| (running && (npaths > 1 || watching))
+			|| (listing && (npaths > 1 || onepass || watching || running))
+			|| (optimize && (onepass || watching || listing))) {
+		usage(argv[0]);
+	}
+	if (njobs == 0) {
+		njobs = 1;
+	}
+	if (njobs > npaths) {
+		njobs = npaths;
+	}
+
+	struct batch batch = {
+		calloc(npaths, sizeof(struct job)),
+		calloc(njobs, sizeof(struct a80 *)),
+		malloc(njobs * sizeof(struct a80_image)),
+		onepass,
+		full,
+		optimize,
+		cachedir,
+	};
+	if (batch.jobs == NULL || batch.ctxs == NULL || batch.images == NULL) {
+		perror("malloc");
+		exit(EXIT_FAILURE);
 	}
-
-	/* Record address of label declarations. */
-	pass = 1;
-	for (line = lines->head; line != NULL; line = line->next, ++lineno) {
-		parse((char *)line->value);
-		process();
+	for (size_t i = 0; i < njobs; ++i) {
+		if ((batch.ctxs[i] = a80_new()) == NULL) {
+			perror("malloc");
+			exit(EXIT_FAILURE);
+		}
+		a80_setthreads(batch.ctxs[i], nthreads);
+		a80_setoptimize(batch.ctxs[i], optimize);
 	}
-
-	/* Generate object code. */
-	pass = 2, lineno = 0;
-	for (line = linesdup->head; line != NULL; line = line->next, ++lineno) {
-		parse((char *)line->value);
-		process();
+	for (size_t i = 0; i < npaths; ++i) {
+		batch.jobs[i].path = paths[i];
 	}
 
-	freelist(linesdup);
-}
-
-int
-main(int argc, char *argv[])
-{
-	FILE *istream, *ostream;
-	char *line = NULL;
-	size_t len = 0;
-	ssize_t nread;
-
-	if (argc != 2) {
-		fprintf(stderr, "usage: %s <file.asm>\n", argv[0]);
+	if (watching) {
+		/* Returns only if the source cannot be watched. */
+		watch(batch.ctxs[0], &batch.images[0], &batch.jobs[0], &batch);
 		exit(EXIT_FAILURE);
 	}
 
-	istream = fopen(argv[1], "r");
-	if (istream == NULL) {
-		perror("fopen");
-		exit(EXIT_FAILURE);
+	if (listing) {
+		status = listfile(batch.ctxs[0], &batch.images[0], &batch.jobs[0],
+				&batch);
+		exit(status == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
 	}
 
-	struct list *lines = initlist();
-	while ((nread = getline(&line, &len, istream)) != -1) {
-		append(lines, strdup(line));
+	if (running) {
+		status = runfile(batch.ctxs[0], &batch.images[0], &batch.jobs[0],
+				&batch, stats);
+		exit(status == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
 	}
-	free(line);
 
-	symtabs = initlist();
-	assemble(lines);
+	parallelfor(njobs, npaths, runjob, &batch);
 
-	char *ext = strchr(argv[1], '.');
-	*ext = '\0';
+	/* Report in the order the files were given, however they were run. */
+	struct job total = { 0 };
+	for (size_t i = 0; i < npaths; ++i) {
+		struct job *job = &batch.jobs[i];
 
-	ostream = fopen(argv[1], "w+");
-	if (ostream == NULL) {
-		perror("fopen");
-		exit(EXIT_FAILURE);
+		if (job->ret != 0) {
+			printerror(job, npaths > 1);
+			status = EXIT_FAILURE;
+		}
+
+		total.read += job->read;
+		total.write += job->write;
+		total.hits += job->hits;
+		total.stats.lines += job->stats.lines;
+		total.stats.allocations += job->stats.allocations;
+		total.stats.mallocs += job->stats.mallocs;
+		total.stats.bytes += job->stats.bytes;
+		total.stats.symbols += job->stats.symbols;
+		total.stats.lookups += job->stats.lookups;
+		total.stats.probes += job->stats.probes;
+		total.stats.memolookups += job->stats.memolookups;
+		total.stats.recalled += job->stats.recalled;
+		total.stats.dispatches += job->stats.dispatches;
+		total.stats.emitted += job->stats.emitted;
+		total.stats.peepholes += job->stats.peepholes;
+		total.stats.savedbytes += job->stats.savedbytes;
+		total.stats.savedtstates += job->stats.savedtstates;
+		total.stats.pruned += job->stats.pruned;
+		total.stats.prunedbytes += job->stats.prunedbytes;
+		total.stats.pass1 += job->stats.pass1;
+		total.stats.pass2 += job->stats.pass2;
+		if (job->stats.peak > total.stats.peak) {
+			total.stats.peak = job->stats.peak;
+		}
 	}
-	fwrite(output, sizeof(unsigned char), sizeof(output), ostream);
 
-	freelist(lines);
-	freelist(symtabs);
-	fclose(istream);
-	fclose(ostream);
+	if (stats != STATS_NONE && status == EXIT_SUCCESS) {
+		printstats(stats, &total);
+	}
+
+	for (size_t i = 0; i < njobs; ++i) {
+		a80_free(batch.ctxs[i]);
+	}
+	free(batch.ctxs);
+	free(batch.images);
+	free(batch.jobs);
+	free(paths);
 
-	exit(EXIT_SUCCESS);
+	exit(status);
 }
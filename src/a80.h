@@ -0,0 +1,85 @@
+#ifndef A80_H
+#define A80_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define A80_IMAGESIZE 65536
+
+/* Optimizations for a80_setoptimize(). */
+#define A80_PEEPHOLE 1
+#define A80_PRUNE 2
+
+/*
+ * An assembler context. Contexts share no state with one another, so each
+ * thread may assemble with its own concurrently.
+ */
+struct a80;
+
+/*
+ * The 8080 address space. Object code is placed at the address it is
+ * assembled for, and [lo, hi) spans every byte written.
+ */
+struct a80_image {
+	unsigned char bytes[A80_IMAGESIZE];
+	size_t lo;
+	size_t hi;
+};
+
+struct a80_stats {
+	size_t lines;
+	size_t allocations;	/* arena allocations */
+	size_t mallocs;		/* arena blocks obtained from malloc() */
+	size_t bytes;		/* arena bytes handed out */
+	size_t peak;		/* arena bytes held in blocks */
+	size_t symbols;		/* labels defined */
+	size_t lookups;		/* symbol table lookups */
+	size_t probes;		/* occupied slots examined by lookups */
+	size_t memolookups;	/* lines looked up among those encoded before */
+	size_t recalled;	/* lines whose earlier encoding was reused */
+	size_t dispatches;	/* mnemonics dispatched to a handler */
+	size_t emitted;		/* bytes of object code written */
+	size_t peepholes;	/* rewrites by the optimizer */
+	size_t savedbytes;	/* bytes of object code they saved */
+	size_t savedtstates;	/* T-states, once through each rewrite */
+	size_t pruned;		/* unreachable blocks dropped */
+	size_t prunedbytes;	/* bytes of object code in them */
+	double pass1;		/* seconds lexing lines */
+	double pass2;		/* seconds emitting and patching */
+};
+
+/* An instruction as the assembler encodes it. */
+struct a80_insn {
+	const char *name;	/* mnemonic */
+	unsigned char size;	/* bytes, including the opcode */
+	unsigned char arg1;	/* register, pair or vector of each operand */
+	unsigned char arg2;
+	unsigned char cycles;	/* T-states, if a condition holds */
+	unsigned char untaken;	/* and if it does not */
+};
+
+/* A line of a source, as last assembled. */
+struct a80_line {
+	size_t offset;		/* of its first character in the source */
+	const char *label;	/* defined at its address, or NULL */
+	unsigned short addr;	/* of its first byte, or that an org sets */
+	unsigned short size;	/* bytes of object code or space */
+	int opcode;		/* of the instruction it encodes, or -1 */
+	long operand;		/* value of a 16-bit operand, or -1 */
+};
+
+struct a80 *a80_new(void);
+void a80_setthreads(struct a80 *ctx, size_t n);
+void a80_setoptimize(struct a80 *ctx, int flags);
+void a80_free(struct a80 *ctx);
+int a80_assemble(struct a80 *ctx, const char *buf, size_t len, struct a80_image *out);
+int a80_reassemble(struct a80 *ctx, const char *buf, size_t len, struct a80_image *out);
+int a80_assemblestream(struct a80 *ctx, FILE *stream, struct a80_image *out);
+const char *a80_error(const struct a80 *ctx);
+size_t a80_errline(const struct a80 *ctx);
+void a80_stats(const struct a80 *ctx, struct a80_stats *stats);
+int a80_decode(unsigned char opcode, struct a80_insn *insn);
+size_t a80_nlines(const struct a80 *ctx);
+void a80_line(const struct a80 *ctx, size_t i, struct a80_line *line);
+
+#endif
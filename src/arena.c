@@ -0,0 +1,118 @@
+#include <stddef.h>
+#include <string.h>
+
+#include "arena.h"
+
+#define BLOCKSIZE 65536
+
+struct block {
+	struct block *next;
+	size_t size;
+	size_t used;
+	max_align_t data[];
+};
+
+static size_t
+align(size_t size)
+{
+	return (size + sizeof(max_align_t) - 1) & ~(sizeof(max_align_t) - 1);
+}
+
+void *
+arenaalloc(struct arena *arena, size_t size)
+{
+	struct block *b = arena->head;
+
+	size = align(size);
+	if (b == NULL || b->size - b->used < size) {
+		size_t bsize = size > BLOCKSIZE ? size : BLOCKSIZE;
+		if ((b = malloc(sizeof(struct block) + bsize)) == NULL) {
+			return NULL;
+		}
+		b->next = arena->head;
+		b->size = bsize;
+		b->used = 0;
+		arena->head = b;
+		++arena->nblocks;
+		arena->nreserved += bsize;
+	}
+
+	void *p = (char *)b->data + b->used;
+	b->used += size;
+	++arena->nallocs;
+	arena->nbytes += size;
+
+	return p;
+}
+
+/*
+ * Resize the allocation at p. The most recent allocation of the current
+ * block is extended in place when there is room; any other is copied into
+ * fresh space and its old storage abandoned until the arena is freed.
+ */
+void *
+arenagrow(struct arena *arena, void *p, size_t oldsize, size_t newsize)
+{
+	struct block *b = arena->head;
+
+	if (p == NULL) {
+		return arenaalloc(arena, newsize);
+	}
+
+	oldsize = align(oldsize);
+	newsize = align(newsize);
+	if (b != NULL && (char *)p + oldsize == (char *)b->data + b->used
+			&& b->size - b->used >= newsize - oldsize) {
+		b->used += newsize - oldsize;
+		++arena->nallocs;
+		arena->nbytes += newsize - oldsize;
+		return p;
+	}
+
+	void *q = arenaalloc(arena, newsize);
+	if (q != NULL) {
+		memcpy(q, p, oldsize);
+	}
+	return q;
+}
+
+/*
+ * Release every allocation, keeping one block around so that an arena used
+ * repeatedly does not return to malloc() each time.
+ */
+void
+arenareset(struct arena *arena)
+{
+	struct block *keep = NULL;
+	struct block *b = arena->head;
+
+	while (b != NULL) {
+		struct block *next = b->next;
+		if (keep == NULL && b->size == BLOCKSIZE) {
+			keep = b;
+			keep->next = NULL;
+			keep->used = 0;
+		} else {
+			free(b);
+		}
+		b = next;
+	}
+
+	arena->head = keep;
+	arena->nallocs = 0;
+	arena->nblocks = 0;
+	arena->nbytes = 0;
+	arena->nreserved = keep ? keep->size : 0;
+}
+
+void
+freearena(struct arena *arena)
+{
+	struct block *b = arena->head;
+	while (b != NULL) {
+		struct block *next = b->next;
+		free(b);
+		b = next;
+	}
+	arena->head = NULL;
+}
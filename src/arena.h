@@ -0,0 +1,25 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdlib.h>
+
+struct block;
+
+/*
+ * A bump allocator. Allocations are carved from large blocks and are only
+ * ever released together, when the arena itself is freed.
+ */
+struct arena {
+	struct block *head;
+	size_t nallocs;		/* calls to arenaalloc() and arenagrow() */
+	size_t nblocks;		/* calls to malloc() */
+	size_t nbytes;		/* bytes handed out */
+	size_t nreserved;	/* bytes held in blocks */
+};
+
+void *arenaalloc(struct arena *arena, size_t size);
+void *arenagrow(struct arena *arena, void *p, size_t oldsize, size_t newsize);
+void arenareset(struct arena *arena);
+void freearena(struct arena *arena);
+
+#endif
@@ -0,0 +1,2884 @@
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "a80.h"
+#include "arena.h"
+#include "ir.h"
+#include "lex.h"
+#include "pool.h"
+#include "symtab.h"
+
+/* Slots of the cache of encoded lines; a power of two. */
+#define NMEMO 1024
+
+/* Pieces of a source lexed concurrently are no smaller than this. */
+#define CHUNKMIN (256 * 1024)
+
+/* Both macros expect the assembler context `ctx` to be in scope. */
+#define errmsg(fmt, ...) \
+	do { \
+		snprintf(ctx->err, sizeof(ctx->err), #fmt, __VA_ARGS__); \
+		ctx->errline = ctx->lineno; \
+		longjmp(ctx->env, 1); \
+	} while(0)
+#define assertarg(args) \
+	do { \
+		if (!(args)) \
+			errmsg("%s", "arguments not correct for mnemonic"); \
+	} while (0)
+
+/* Classes of operand accepted by an instruction. */
+enum arg {
+	ARG_NONE,
+	ARG_REG,	/* b, c, d, e, h, l, m or a */
+	ARG_PAIR,	/* b, d, h or sp */
+	ARG_STACK,	/* b, d, h or psw */
+	ARG_INDEX,	/* b or d */
+	ARG_VECTOR,	/* reset vector 0 through 7 */
+	ARG_IMM8,	/* byte, or the low byte of a label */
+	ARG_IMM16,	/* word or label */
+};
+
+/*
+ * A run of characters within the source. Tokens refer directly into the
+ * input rather than to copies of it, so they are not NUL-terminated. A
+ * token that is absent from the line has a NULL pointer.
+ */
+struct span {
+	const char *s;
+	size_t len;
+};
+
+/* What a line of a resident source contributed to the last assembly. */
+struct lineinfo {
+	size_t offset;		/* of its first character in the source */
+	long entry;		/* IR entry, or -1 */
+	long sym;		/* symbol defined, or -1 */
+	unsigned short start;	/* address before the line */
+	unsigned short end;	/* and after it */
+	unsigned char flags;
+};
+
+enum {
+	LINE_ORG = 1 << 0,	/* sets the address outright */
+	LINE_EQU = 1 << 1,	/* defines a symbol other than its address */
+	LINE_DOLLAR = 1 << 2,	/* and the value depends on the address */
+};
+
+/*
+ * A label defined within a chunk of a source lexed apart from the rest.
+ * Until its first org, a chunk knows addresses only relative to its own
+ * start, so a relative value is rebased once the chunk is placed; equ $
+ * then applies its operator to the rebased address. The optimizations
+ * record labels likewise, along with each org and root, to move them once
+ * they have shrunk the entries before them.
+ */
+struct def {
+	unsigned long sym;	/* or ORGDEF or ROOTDEF */
+	size_t lineno;
+	size_t entry;		/* entries lexed before it */
+	unsigned short value;
+	unsigned char relative;
+	char op;
+	unsigned short rhs;
+};
+
+#define ORGDEF ULONG_MAX
+#define ROOTDEF (ULONG_MAX - 1)
+
+/*
+ * The entry that a line of source text produced, for lines whose only
+ * effect is one entry without a label or a reference to one. The text is
+ * that of the source being assembled, so an entry from another assembly,
+ * whose generation differs, is ignored.
+ */
+struct memo {
+	const char *s;
+	size_t len;
+	uint64_t hash;
+	unsigned long gen;
+	unsigned long arg;
+	short opcode;
+	unsigned short size;
+	unsigned char op;
+	unsigned char kind;
+};
+
+/* A piece of a source lexed by a context of its own. */
+struct chunk {
+	struct a80 *ctx;
+	const char *buf;
+	size_t len;
+	size_t firstline;	/* lines before the chunk */
+	unsigned short base;	/* address at which it starts */
+	long *map;		/* global id of each of its symbols */
+	size_t mapcap;
+	size_t lo;		/* addresses its object code spans */
+	size_t hi;
+	int failed;
+};
+
+struct a80 {
+	struct arena arena;
+	struct symtab *symtabs;
+	struct ir *ir;
+	unsigned char *output;
+	unsigned short addr;
+	size_t lineno;
+
+	/* Range of addresses written so far; empty while hi is zero. */
+	size_t lo;
+	size_t hi;
+
+	/* Mnemonic id and IR entry of the line being processed, if any. */
+	unsigned char op;
+	long cur;
+
+	/* FORMAT [label:] [mnemonic [operand1[, operand2]]] [; comment] */
+	struct span label;
+	struct span mnemonic;
+	struct span operand1;
+	struct span operand2;
+	struct span comment;
+
+	/* Encoded lines, indexed by a hash of their text. */
+	struct memo *memo;
+	unsigned long memogen;
+
+	/* Counters and seconds spent in each pass of the last assembly. */
+	size_t nrecalled;
+	size_t nforgotten;
+	size_t nsymbols;
+	size_t ndispatches;
+	size_t nemitted;
+	double pass1;
+	double pass2;
+
+	/*
+	 * State kept by a80_reassemble() between revisions of a source: its
+	 * text, what each of its lines produced, which bytes of the output
+	 * are written, and the symbols whose values moved in an update.
+	 */
+	int track;
+	int resident;
+	int overlap;
+	char *src;
+	size_t srclen;
+	size_t srccap;
+	struct lineinfo *lines;
+	size_t nlines;
+	size_t linescap;
+	size_t ndead;
+	unsigned long *moved;
+	size_t nmoved;
+	size_t movedcap;
+	unsigned char *marks;
+	size_t markscap;
+	uint64_t used[A80_IMAGESIZE / 64];
+	long defsym;
+	unsigned char lineflags;
+
+	/*
+	 * The T-states allowed the block that the last tmax began, while the
+	 * block lasts, and those its instructions have taken so far.
+	 */
+	int budgeted;
+	size_t budgetline;
+	unsigned long budget;
+	unsigned long spent;
+	size_t nbudgets;
+
+	/*
+	 * Pass 1 of a large source is split over up to nthreads chunks. A
+	 * chunk context records the labels it defines in order, along with
+	 * the number of entries lexed before its first org.
+	 */
+	size_t nthreads;
+	struct chunk *chunks;
+	size_t nchunks;
+	size_t chunkscap;
+	int chunked;
+	int orged;
+	size_t relentries;
+	struct def *defs;
+	size_t ndefs;
+	size_t defscap;
+	char dollarop;
+	unsigned short dollarrhs;
+
+	/*
+	 * The optimizations of the entries of pass 1 asked for, those made in
+	 * this assembly, and what they saved.
+	 */
+	int optimize;
+	int optimizing;
+	size_t npeepholes;
+	size_t nsavedbytes;
+	size_t nsavedtstates;
+	size_t npruned;
+	size_t nprunedbytes;
+
+	/*
+	 * Line buffer of a80_assemblestream(), kept across errors, and the line
+	 * that last wrote each byte of the output while it runs.
+	 */
+	char *line;
+	size_t linecap;
+	int streaming;
+	size_t *writer;
+
+	jmp_buf env;
+	size_t errline;
+	char err[128];
+};
+
+static struct span
+strip(const char *s, const char *e)
+{
+	while (s < e && isspace((unsigned char)*s)) ++s;
+	while (e > s && isspace((unsigned char)e[-1])) --e;
+
+	return (struct span){ s, (size_t)(e - s) };
+}
+
+static int
+speq(struct span t, const char *s)
+{
+	return t.s != NULL && strncmp(t.s, s, t.len) == 0 && s[t.len] == '\0';
+}
+
+/*
+ * A line and, if it fits in LEXWIDTH characters, the classes of its
+ * characters. Separators are found in the masks with bit arithmetic;
+ * longer lines, which are rare, are scanned instead. Positions are
+ * offsets from the start of the line.
+ */
+struct line {
+	const char *s;
+	size_t n;
+	struct lexmask m;
+};
+
+static uint64_t
+span64(size_t from, size_t to)
+{
+	uint64_t below = to >= 64 ? ~(uint64_t)0 : ((uint64_t)1 << to) - 1;
+	uint64_t above = from >= 64 ? 0 : ~(((uint64_t)1 << from) - 1);
+	return below & above;
+}
+
+/* Return the position of the first c in [from, to), or -1. */
+static long
+firstof(const struct line *l, uint64_t mask, char c, size_t from, size_t to)
+{
+	if (l->n <= LEXWIDTH) {
+		mask &= span64(from, to);
+		return mask ? __builtin_ctzll(mask) : -1;
+	}
+
+	const char *p = memchr(l->s + from, c, to - from);
+	return p ? p - l->s : -1;
+}
+
+/* Return the position of the last white space in [from, to), or -1. */
+static long
+lastspace(const struct line *l, size_t from, size_t to)
+{
+	if (l->n <= LEXWIDTH) {
+		uint64_t mask = l->m.space & span64(from, to);
+		return mask ? 63 - __builtin_clzll(mask) : -1;
+	}
+
+	while (to > from) {
+		if (isspace((unsigned char)l->s[--to])) {
+			return (long)to;
+		}
+	}
+	return -1;
+}
+
+/* As strip(), over [from, to) of the line. */
+static struct span
+trim(const struct line *l, size_t from, size_t to)
+{
+	if (l->n <= LEXWIDTH) {
+		uint64_t mask = ~l->m.space & span64(from, to);
+		if (mask == 0) {
+			return (struct span){ l->s + to, 0 };
+		}
+		size_t first = __builtin_ctzll(mask);
+		size_t last = 63 - __builtin_clzll(mask);
+		return (struct span){ l->s + first, last - first + 1 };
+	}
+
+	return strip(l->s + from, l->s + to);
+}
+
+/*
+ * Return the position of the first semicolon in [from, to) that is not
+ * within quotes, or -1. A quote left open runs to the end of the line.
+ */
+static long
+comment(const struct line *l, size_t from, size_t to)
+{
+	long p, q;
+
+	while ((p = firstof(l, l->m.semi, ';', from, to)) >= 0) {
+		if ((q = firstof(l, l->m.quote, '\'', from, p)) < 0) {
+			return p;
+		}
+		if ((q = firstof(l, l->m.quote, '\'', q + 1, to)) < 0) {
+			return -1;
+		}
+		from = q + 1;
+	}
+	return -1;
+}
+
+/*
+ * Split the n characters at s into tokens. If m is not NULL, it holds the
+ * masks of those characters, as found by nextline().
+ */
+static void
+parse(struct a80 *ctx, const char *s, size_t n, const struct lexmask *m)
+{
+	static const struct span none;
+	struct line l = { s, n, { 0 } };
+	int quoted = 0;
+	long p, q;
+
+	ctx->label = none;
+	ctx->mnemonic = none;
+	ctx->operand1 = none;
+	ctx->operand2 = none;
+	ctx->comment = none;
+
+	if (m != NULL) {
+		l.m = *m;
+	} else if (n <= LEXWIDTH) {
+		classify(s, n, &l.m);
+	}
+
+	struct span line = trim(&l, 0, n);
+	if (line.len == 0) return;
+
+	size_t start = line.s - s;
+	size_t end = start + line.len;
+
+	if ((p = comment(&l, start, end)) >= 0) {
+		if ((size_t)p == start) {
+			return;
+		}
+
+		ctx->comment = trim(&l, p + 1, end);
+		end = p;
+	}
+
+	/*
+	 * If there exists a single quote or tick in the line after the comment
+	 * has been tokenized and separated, then `operand1` consists of a
+	 * string and `operand2` is empty.
+	 *
+	 * This condition exists for mnemonicuction `db`. A single character in
+	 * quotes is instead a literal operand, and its characters are kept out
+	 * of the search for separators below by lim.
+	 */
+	size_t lim = end;
+	if ((p = firstof(&l, l.m.quote, '\'', start, end)) >= 0) {
+		if ((q = firstof(&l, l.m.quote, '\'', p + 1, end)) < 0) {
+			errmsg("%s", "unterminated string");
+		}
+		if (q == p + 2) {
+			lim = p;
+		} else {
+			ctx->operand1 = trim(&l, p + 1, end);
+			ctx->operand1.len = s + q - ctx->operand1.s;
+			end = lim = p;
+			quoted = 1;
+		}
+	}
+	if (!quoted && (p = firstof(&l, l.m.comma, ',', start, lim)) >= 0) {
+		ctx->operand2 = trim(&l, p + 1, end);
+		end = lim = p;
+	}
+
+	/* A label runs from the start of the line to a colon, without blanks. */
+	if ((p = firstof(&l, l.m.colon, ':', start, lim)) >= 0
+			&& lastspace(&l, start, p) < 0) {
+		ctx->label = (struct span){ s + start, p - start };
+		start = p + 1;
+	}
+
+	/* The mnemonic is separated from operand1 by the last blank after it. */
+	struct span head = trim(&l, start, end);
+	start = head.s - s;
+	end = start + head.len;
+	if (!quoted && (p = lastspace(&l, start, lim < end ? lim : end)) >= 0) {
+		ctx->operand1 = trim(&l, p + 1, end);
+		head = trim(&l, start, p);
+	}
+	if (head.len > 0) {
+		ctx->mnemonic = head;
+	}
+}
+
+/*
+ * T-states taken by each opcode. A conditional call or return takes the
+ * figure given here when its condition holds and 6 fewer when it does not.
+ */
+static const unsigned char tstates[256] = {
+	4, 10, 7, 5, 5, 5, 7, 4, 4, 10, 7, 5, 5, 5, 7, 4,
+	4, 10, 7, 5, 5, 5, 7, 4, 4, 10, 7, 5, 5, 5, 7, 4,
+	4, 10, 16, 5, 5, 5, 7, 4, 4, 10, 16, 5, 5, 5, 7, 4,
+	4, 10, 13, 5, 10, 10, 10, 4, 4, 10, 13, 5, 5, 5, 7, 4,
+	5, 5, 5, 5, 5, 5, 7, 5, 5, 5, 5, 5, 5, 5, 7, 5,
+	5, 5, 5, 5, 5, 5, 7, 5, 5, 5, 5, 5, 5, 5, 7, 5,
+	5, 5, 5, 5, 5, 5, 7, 5, 5, 5, 5, 5, 5, 5, 7, 5,
+	7, 7, 7, 7, 7, 7, 7, 7, 5, 5, 5, 5, 5, 5, 7, 5,
+	4, 4, 4, 4, 4, 4, 7, 4, 4, 4, 4, 4, 4, 4, 7, 4,
+	4, 4, 4, 4, 4, 4, 7, 4, 4, 4, 4, 4, 4, 4, 7, 4,
+	4, 4, 4, 4, 4, 4, 7, 4, 4, 4, 4, 4, 4, 4, 7, 4,
+	4, 4, 4, 4, 4, 4, 7, 4, 4, 4, 4, 4, 4, 4, 7, 4,
+	11, 10, 10, 10, 17, 11, 7, 11, 11, 10, 10, 10, 17, 17, 7, 11,
+	11, 10, 10, 10, 17, 11, 7, 11, 11, 10, 10, 10, 17, 17, 7, 11,
+	11, 10, 10, 18, 17, 11, 7, 11, 11, 5, 10, 4, 17, 17, 7, 11,
+	11, 10, 10, 4, 17, 11, 7, 11, 11, 5, 10, 4, 17, 17, 7, 11,
+};
+
+/*
+ * End the block under the budget of a tmax, if one is open. Every
+ * instruction takes some T-states, so a block that has spent none holds
+ * no instructions.
+ */
+static void
+endbudget(struct a80 *ctx)
+{
+	if (!ctx->budgeted) {
+		return;
+	}
+	ctx->budgeted = 0;
+	if (ctx->spent == 0) {
+		ctx->lineno = ctx->budgetline;
+		errmsg("%s", "no instructions under tmax");
+	}
+	if (ctx->spent > ctx->budget) {
+		ctx->lineno = ctx->budgetline;
+		errmsg("block takes %lu T-states, over its budget of %lu",
+				ctx->spent, ctx->budget);
+	}
+}
+
+/* Record the definition of sym, or an org, at the current address. */
+static void
+pushdef(struct a80 *ctx, unsigned long sym)
+{
+	if (ctx->ndefs == ctx->defscap) {
+		size_t cap = ctx->defscap ? ctx->defscap * 2 : 256;
+		struct def *defs = realloc(ctx->defs, cap * sizeof(*defs));
+		if (defs == NULL) {
+			errmsg("%s", "unable to allocate symbol");
+		}
+		ctx->defs = defs;
+		ctx->defscap = cap;
+	}
+	ctx->defs[ctx->ndefs++] = (struct def){
+		sym, ctx->lineno, ctx->ir->len, ctx->addr, !ctx->orged, 0, 0,
+	};
+}
+
+static void
+addsym(struct a80 *ctx)
+{
+	long id = intern(ctx->symtabs, ctx->label.s, ctx->label.len);
+	if (id < 0) {
+		errmsg("%s", "unable to allocate symbol");
+	}
+
+	struct symbol *sym = &ctx->symtabs->syms[id];
+	if (sym->defined) {
+		errmsg("duplicate label %.*s",
+				(int)ctx->label.len, ctx->label.s);
+	}
+	sym->value = ctx->addr;
+	sym->defined = 1;
+	ctx->defsym = id;
+
+	/* A label ahead of the first instruction under a tmax joins its block. */
+	if (!(ctx->lineflags & LINE_EQU) && ctx->spent > 0) {
+		endbudget(ctx);
+	}
+	++ctx->nsymbols;
+
+	if (ctx->chunked || ctx->optimizing) {
+		pushdef(ctx, (unsigned long)id);
+	}
+}
+
+static long
+entry(struct a80 *ctx)
+{
+	if (ctx->cur < 0) {
+		if ((ctx->cur = irappend(ctx->ir)) < 0) {
+			errmsg("%s", "unable to allocate line");
+		}
+		ctx->ir->op[ctx->cur] = ctx->op;
+		ctx->ir->addr[ctx->cur] = ctx->addr;
+		ctx->ir->lineno[ctx->cur] = ctx->lineno;
+	}
+	return ctx->cur;
+}
+
+static void
+instr(struct a80 *ctx, unsigned short size, int opcode)
+{
+	if (ctx->label.s) {
+		addsym(ctx);
+	}
+	if (opcode >= 0) {
+		long i = entry(ctx);
+		ctx->ir->opcode[i] = (short)opcode;
+	}
+	ctx->addr += size;
+}
+
+static int
+isnum(struct span t)
+{
+	return t.len > 0 && (isdigit((unsigned char)t.s[0]) || t.s[0] == '\'');
+}
+
+/* Return the value of digit c in base, or -1 if c is not such a digit. */
+static int
+digit(int c, int base)
+{
+	int d;
+
+	if (c >= '0' && c <= '9') {
+		d = c - '0';
+	} else if ((c | 0x20) >= 'a' && (c | 0x20) <= 'f') {
+		d = (c | 0x20) - 'a' + 10;
+	} else {
+		return -1;
+	}
+	return d < base ? d : -1;
+}
+
+/*
+ * Convert the literal t, no greater than max, in a single pass. A literal
+ * is a character in quotes, digits prefixed by 0x, or digits with an
+ * optional suffix for their base: h, b, o or q, or d.
+ */
+static unsigned short
+numcheck(struct a80 *ctx, struct span t, unsigned max)
+{
+	const char *s = t.s, *end = t.s + t.len;
+	unsigned long num = 0;
+	int base = 10;
+
+	if (t.len == 0) {
+		errmsg("%s", "no digits present");
+	}
+
+	if (*s == '\'') {
+		if (t.len != 3 || s[2] != '\'') {
+			errmsg("invalid character literal %.*s", (int)t.len, t.s);
+		}
+		num = (unsigned char)s[1];
+		s = end;
+	} else if (t.len > 2 && s[0] == '0' && (s[1] | 0x20) == 'x') {
+		base = 16;
+		s += 2;
+	} else {
+		switch (end[-1] | 0x20) {
+		case 'h': base = 16; --end; break;
+		case 'b': base = 2; --end; break;
+		case 'o': case 'q': base = 8; --end; break;
+		case 'd': base = 10; --end; break;
+		}
+		if (s == end) {
+			errmsg("%s", "no digits present");
+		}
+	}
+
+	for (; s < end; ++s) {
+		int d = digit(*s, base);
+		if (d < 0) {
+			errmsg("invalid number %.*s", (int)t.len, t.s);
+		}
+		num = num * base + d;
+		if (num > max) {
+			errmsg("number %.*s out of range", (int)t.len, t.s);
+		}
+	}
+
+	return (unsigned short)num;
+}
+
+static unsigned long
+symref(struct a80 *ctx, struct span name)
+{
+	long id = intern(ctx->symtabs, name.s, name.len);
+	if (id < 0) {
+		errmsg("%s", "unable to allocate symbol");
+	}
+	return (unsigned long)id;
+}
+
+static unsigned short
+symvalue(struct a80 *ctx, unsigned long id)
+{
+	struct symbol *sym = &ctx->symtabs->syms[id];
+	if (!sym->defined) {
+		errmsg("label %s undefined", sym->label);
+	}
+	return sym->value;
+}
+
+/* Record t, a number or a label, as the operand of entry i. */
+static void
+immediate(struct a80 *ctx, long i, struct span t, int wide)
+{
+	if (isnum(t)) {
+		ctx->ir->kind[i] = wide ? IR_IMM16 : IR_IMM8;
+		ctx->ir->arg[i] = numcheck(ctx, t, wide ? 0xffff : 0xff);
+	} else {
+		ctx->ir->kind[i] = wide ? IR_SYM16 : IR_SYM8;
+		ctx->ir->arg[i] = symref(ctx, t);
+	}
+}
+
+static const char *const regs[] = { "b", "c", "d", "e", "h", "l", "m", "a" };
+static const char *const pairs[] = { "b", "d", "h", "sp" };
+static const char *const stackpairs[] = { "b", "d", "h", "psw" };
+
+/* Return the number that encodes operand t, of class c, within an opcode. */
+static int
+field(struct a80 *ctx, enum arg c, struct span t)
+{
+	switch (c) {
+	case ARG_REG:
+		for (int r = 0; r < 8; ++r) {
+			if (speq(t, regs[r])) return r;
+		}
+		errmsg("invalid register %.*s", (int)t.len, t.s);
+	case ARG_PAIR:
+		for (int r = 0; r < 4; ++r) {
+			if (speq(t, pairs[r])) return r;
+		}
+		if (speq(t, "psw")) {
+			errmsg("psw may not be used with %.*s",
+					(int)ctx->mnemonic.len, ctx->mnemonic.s);
+		}
+		errmsg("invalid register pair %.*s", (int)t.len, t.s);
+	case ARG_STACK:
+		for (int r = 0; r < 4; ++r) {
+			if (speq(t, stackpairs[r])) return r;
+		}
+		if (speq(t, "sp")) {
+			errmsg("sp may not be used with %.*s",
+					(int)ctx->mnemonic.len, ctx->mnemonic.s);
+		}
+		errmsg("invalid register pair %.*s", (int)t.len, t.s);
+	case ARG_INDEX:
+		if (speq(t, "b")) return 0;
+		if (speq(t, "d")) return 1;
+		errmsg("%.*s operates on registers b and d",
+				(int)ctx->mnemonic.len, ctx->mnemonic.s);
+	case ARG_VECTOR: {
+		unsigned short n = numcheck(ctx, t, 0xffff);
+		if (n > 7) {
+			errmsg("invalid reset vector %.*s", (int)t.len, t.s);
+		}
+		return n;
+	}
+	default:
+		return 0;
+	}
+}
+
+/* Apply the operator of an equ $ expression, if any, to the address num. */
+static unsigned short
+applyop(unsigned short num, char op, unsigned short rhs)
+{
+	switch (op) {
+	case '+': return num + rhs;
+	case '-': return num - rhs;
+	case '*': return num * rhs;
+	case '/': return num / rhs;
+	case '%': return num % rhs;
+	default: return num;
+	}
+}
+
+static unsigned short
+dollar(struct a80 *ctx)
+{
+	struct span rhs = { ctx->operand1.s + 2, ctx->operand1.len < 2 ? 0 : ctx->operand1.len - 2 };
+
+	ctx->dollarop = 0;
+	ctx->dollarrhs = 0;
+	if (ctx->operand1.len > 1) {
+		ctx->dollarop = ctx->operand1.s[1];
+		switch (ctx->dollarop) {
+		case '+': case '-': case '*': case '/': case '%':
+			break;
+		default:
+			errmsg("%s", "invalid operator in equ");
+		}
+		ctx->dollarrhs = numcheck(ctx, rhs, 0xffff);
+		if (ctx->dollarrhs == 0 && (ctx->dollarop == '/' || ctx->dollarop == '%')) {
+			errmsg("%s", "division by zero");
+		}
+	}
+
+	return applyop(ctx->addr, ctx->dollarop, ctx->dollarrhs);
+}
+
+static void
+name(struct a80 *ctx)
+{
+	assertarg(!ctx->label.s && ctx->operand1.s && !ctx->operand2.s);
+}
+
+static void
+title(struct a80 *ctx)
+{
+	assertarg(!ctx->label.s && ctx->operand1.s && !ctx->operand2.s);
+}
+
+static void
+end(struct a80 *ctx)
+{
+	assertarg(!ctx->label.s && !ctx->operand1.s && !ctx->operand2.s);
+}
+
+static void
+org(struct a80 *ctx)
+{
+	assertarg(!ctx->label.s && ctx->operand1.s && !ctx->operand2.s);
+
+	ctx->lineflags |= LINE_ORG;
+	if (ctx->chunked && !ctx->orged) {
+		ctx->orged = 1;
+		ctx->relentries = ctx->ir->len;
+	}
+	if (isnum(ctx->operand1)) {
+		ctx->addr = numcheck(ctx, ctx->operand1, 0xffff);
+	} else {
+		errmsg("%s", "org requires a number");
+	}
+	if (ctx->optimizing) {
+		pushdef(ctx, ORGDEF);
+	}
+}
+
+static void
+equ(struct a80 *ctx)
+{
+	unsigned short value;
+
+	if (!ctx->label.s) {
+		errmsg("%s", "equ statement requires a label");
+	}
+
+	ctx->lineflags |= LINE_EQU;
+	if (ctx->operand1.len > 0 && ctx->operand1.s[0] == '$') {
+		ctx->lineflags |= LINE_DOLLAR;
+		value = dollar(ctx);
+	} else {
+		value = numcheck(ctx, ctx->operand1, 0xffff);
+	}
+
+	unsigned short tmp = ctx->addr;
+	ctx->addr = value;
+	addsym(ctx);
+	ctx->addr = tmp;
+
+	/* Only $ depends on where the line lands; keep what it needs. */
+	if (ctx->chunked || ctx->optimizing) {
+		struct def *def = &ctx->defs[ctx->ndefs - 1];
+		if (ctx->lineflags & LINE_DOLLAR) {
+			def->value = tmp;
+			def->op = ctx->dollarop;
+			def->rhs = ctx->dollarrhs;
+		} else {
+			def->relative = 0;
+		}
+	}
+}
+
+static void
+dw(struct a80 *ctx)
+{
+	assertarg(ctx->operand1.s && !ctx->operand2.s);
+
+	if (ctx->label.s) {
+		addsym(ctx);
+	}
+	immediate(ctx, entry(ctx), ctx->operand1, 1);
+
+	ctx->addr += 2;
+}
+
+static void
+ds(struct a80 *ctx)
+{
+	assertarg(ctx->operand1.s && !ctx->operand2.s);
+
+	if (ctx->label.s) {
+		addsym(ctx);
+	}
+	long i = entry(ctx);
+	ctx->ir->kind[i] = IR_SPACE;
+
+	ctx->addr += numcheck(ctx, ctx->operand1, 0xffff);
+}
+
+static void
+db(struct a80 *ctx)
+{
+	assertarg(ctx->operand1.s && !ctx->operand2.s);
+
+	if (isnum(ctx->operand1)) {
+		instr(ctx, 1, numcheck(ctx, ctx->operand1, 0xff));
+	} else {
+		if (ctx->label.s) {
+			addsym(ctx);
+		}
+
+		size_t len = ctx->operand1.len;
+		long offset = irdata(ctx->ir, ctx->operand1.s, len);
+		if (offset < 0) {
+			errmsg("%s", "unable to allocate string");
+		}
+
+		long i = entry(ctx);
+		ctx->ir->kind[i] = IR_DATA;
+		ctx->ir->arg[i] = (unsigned long)offset;
+		ctx->addr += len;
+	}
+}
+
+/*
+ * Fail the assembly if the instructions from here to the next label take
+ * more T-states than the operand, each counted once and a conditional
+ * call or return as though taken.
+ */
+static void
+tmax(struct a80 *ctx)
+{
+	assertarg(ctx->operand1.s && !ctx->operand2.s);
+
+	if (ctx->label.s) {
+		addsym(ctx);
+	}
+	endbudget(ctx);
+	ctx->budget = numcheck(ctx, ctx->operand1, 0xffff);
+	ctx->budgetline = ctx->lineno;
+	ctx->spent = 0;
+	ctx->budgeted = 1;
+	++ctx->nbudgets;
+}
+
+/* Keep the block of this line even if no code can reach it. */
+static void
+root(struct a80 *ctx)
+{
+	assertarg(!ctx->operand1.s && !ctx->operand2.s);
+
+	if (ctx->label.s) {
+		addsym(ctx);
+	}
+	if (ctx->optimizing) {
+		pushdef(ctx, ROOTDEF);
+	}
+}
+
+/*
+ * Mnemonics are at most five characters long, so pack the characters of each
+ * into an integer key and multiply it into a slot. The multiplier was chosen
+ * so that no two mnemonics collide; a collision introduced by a new entry
+ * overrides an initializer and fails the build.
+ */
+#define HASHBITS 8
+#define HASHMUL 0x2db77ca44fcba505ULL
+#define KEY(a, b, c, d, e) \
+	((unsigned long long)(a) | (unsigned long long)(b) << 8 \
+	 | (unsigned long long)(c) << 16 | (unsigned long long)(d) << 24 \
+	 | (unsigned long long)(e) << 32)
+#define HASH(key) ((unsigned)(((key) * HASHMUL) >> (64 - HASHBITS)))
+#define SLOT(a, b, c, d, e) HASH(KEY(a, b, c, d, e))
+
+/*
+ * An instruction is encoded by OR-ing the fields of its register operands,
+ * shifted into place, into the base opcode. An immediate operand follows
+ * the opcode. Directives have no encoding and are handled by a function.
+ */
+struct mnemonic {
+	const char *name;
+	unsigned char opcode;
+	unsigned char size;
+	unsigned char arg1;	/* enum arg */
+	unsigned char arg2;
+	unsigned char shift;	/* position of the field of arg1 */
+	void (*directive)(struct a80 *ctx);
+};
+
+#define INSN(name, opcode, size, arg1, arg2, shift) \
+	{ name, opcode, size, arg1, arg2, shift, NULL }
+#define DIRECTIVE(name, fn) \
+	{ name, 0, 0, ARG_NONE, ARG_NONE, 0, fn }
+
+static const struct mnemonic mnemonics[1 << HASHBITS] = {
+	[SLOT('n', 'o', 'p', 0, 0)] = INSN("nop", 0x00, 1, ARG_NONE, ARG_NONE, 0),
+	[SLOT('m', 'o', 'v', 0, 0)] = INSN("mov", 0x40, 1, ARG_REG, ARG_REG, 3),
+	[SLOT('h', 'l', 't', 0, 0)] = INSN("hlt", 0x76, 1, ARG_NONE, ARG_NONE, 0),
+	[SLOT('a', 'd', 'd', 0, 0)] = INSN("add", 0x80, 1, ARG_REG, ARG_NONE, 0),
+	[SLOT('a', 'd', 'c', 0, 0)] = INSN("adc", 0x88, 1, ARG_REG, ARG_NONE, 0),
+	[SLOT('s', 'u', 'b', 0, 0)] = INSN("sub", 0x90, 1, ARG_REG, ARG_NONE, 0),
+	[SLOT('s', 'b', 'b', 0, 0)] = INSN("sbb", 0x98, 1, ARG_REG, ARG_NONE, 0),
+	[SLOT('a', 'n', 'a', 0, 0)] = INSN("ana", 0xa0, 1, ARG_REG, ARG_NONE, 0),
+	[SLOT('x', 'r', 'a', 0, 0)] = INSN("xra", 0xa8, 1, ARG_REG, ARG_NONE, 0),
+	[SLOT('o', 'r', 'a', 0, 0)] = INSN("ora", 0xb0, 1, ARG_REG, ARG_NONE, 0),
+	[SLOT('c', 'm', 'p', 0, 0)] = INSN("cmp", 0xb8, 1, ARG_REG, ARG_NONE, 0),
+	[SLOT('a', 'd', 'i', 0, 0)] = INSN("adi", 0xc6, 2, ARG_IMM8, ARG_NONE, 0),
+	[SLOT('a', 'c', 'i', 0, 0)] = INSN("aci", 0xce, 2, ARG_IMM8, ARG_NONE, 0),
+	[SLOT('s', 'u', 'i', 0, 0)] = INSN("sui", 0xd6, 2, ARG_IMM8, ARG_NONE, 0),
+	[SLOT('s', 'b', 'i', 0, 0)] = INSN("sbi", 0xde, 2, ARG_IMM8, ARG_NONE, 0),
+	[SLOT('a', 'n', 'i', 0, 0)] = INSN("ani", 0xe6, 2, ARG_IMM8, ARG_NONE, 0),
+	[SLOT('x', 'r', 'i', 0, 0)] = INSN("xri", 0xee, 2, ARG_IMM8, ARG_NONE, 0),
+	[SLOT('o', 'r', 'i', 0, 0)] = INSN("ori", 0xf6, 2, ARG_IMM8, ARG_NONE, 0),
+	[SLOT('c', 'p', 'i', 0, 0)] = INSN("cpi", 0xfe, 2, ARG_IMM8, ARG_NONE, 0),
+	[SLOT('x', 't', 'h', 'l', 0)] = INSN("xthl", 0xe3, 1, ARG_NONE, ARG_NONE, 0),
+	[SLOT('p', 'c', 'h', 'l', 0)] = INSN("pchl", 0xe9, 1, ARG_NONE, ARG_NONE, 0),
+	[SLOT('x', 'c', 'h', 'g', 0)] = INSN("xchg", 0xeb, 1, ARG_NONE, ARG_NONE, 0),
+	[SLOT('s', 'p', 'h', 'l', 0)] = INSN("sphl", 0xf9, 1, ARG_NONE, ARG_NONE, 0),
+	[SLOT('p', 'u', 's', 'h', 0)] = INSN("push", 0xc5, 1, ARG_STACK, ARG_NONE, 4),
+	[SLOT('p', 'o', 'p', 0, 0)] = INSN("pop", 0xc1, 1, ARG_STACK, ARG_NONE, 4),
+	[SLOT('o', 'u', 't', 0, 0)] = INSN("out", 0xd3, 2, ARG_IMM8, ARG_NONE, 0),
+	[SLOT('i', 'n', 0, 0, 0)] = INSN("in", 0xdb, 2, ARG_IMM8, ARG_NONE, 0),
+	[SLOT('d', 'i', 0, 0, 0)] = INSN("di", 0xf3, 1, ARG_NONE, ARG_NONE, 0),
+	[SLOT('e', 'i', 0, 0, 0)] = INSN("ei", 0xfb, 1, ARG_NONE, ARG_NONE, 0),
+	[SLOT('r', 'n', 'z', 0, 0)] = INSN("rnz", 0xc0, 1, ARG_NONE, ARG_NONE, 0),
+	[SLOT('j', 'n', 'z', 0, 0)] = INSN("jnz", 0xc2, 3, ARG_IMM16, ARG_NONE, 0),
+	[SLOT('j', 'm', 'p', 0, 0)] = INSN("jmp", 0xc3, 3, ARG_IMM16, ARG_NONE, 0),
+	[SLOT('c', 'n', 'z', 0, 0)] = INSN("cnz", 0xc4, 3, ARG_IMM16, ARG_NONE, 0),
+	[SLOT('r', 'z', 0, 0, 0)] = INSN("rz", 0xc8, 1, ARG_NONE, ARG_NONE, 0),
+	[SLOT('r', 'e', 't', 0, 0)] = INSN("ret", 0xc9, 1, ARG_NONE, ARG_NONE, 0),
+	[SLOT('j', 'z', 0, 0, 0)] = INSN("jz", 0xca, 3, ARG_IMM16, ARG_NONE, 0),
+	[SLOT('c', 'z', 0, 0, 0)] = INSN("cz", 0xcc, 3, ARG_IMM16, ARG_NONE, 0),
+	[SLOT('c', 'a', 'l', 'l', 0)] = INSN("call", 0xcd, 3, ARG_IMM16, ARG_NONE, 0),
+	[SLOT('r', 'n', 'c', 0, 0)] = INSN("rnc", 0xd0, 1, ARG_NONE, ARG_NONE, 0),
+	[SLOT('j', 'n', 'c', 0, 0)] = INSN("jnc", 0xd2, 3, ARG_IMM16, ARG_NONE, 0),
+	[SLOT('c', 'n', 'c', 0, 0)] = INSN("cnc", 0xd4, 3, ARG_IMM16, ARG_NONE, 0),
+	[SLOT('r', 'c', 0, 0, 0)] = INSN("rc", 0xd8, 1, ARG_NONE, ARG_NONE, 0),
+	[SLOT('j', 'c', 0, 0, 0)] = INSN("jc", 0xda, 3, ARG_IMM16, ARG_NONE, 0),
+	[SLOT('c', 'c', 0, 0, 0)] = INSN("cc", 0xdc, 3, ARG_IMM16, ARG_NONE, 0),
+	[SLOT('r', 'p', 'o', 0, 0)] = INSN("rpo", 0xe0, 1, ARG_NONE, ARG_NONE, 0),
+	[SLOT('j', 'p', 'o', 0, 0)] = INSN("jpo", 0xe2, 3, ARG_IMM16, ARG_NONE, 0),
+	[SLOT('c', 'p', 'o', 0, 0)] = INSN("cpo", 0xe4, 3, ARG_IMM16, ARG_NONE, 0),
+	[SLOT('r', 'p', 'e', 0, 0)] = INSN("rpe", 0xe8, 1, ARG_NONE, ARG_NONE, 0),
+	[SLOT('j', 'p', 'e', 0, 0)] = INSN("jpe", 0xea, 3, ARG_IMM16, ARG_NONE, 0),
+	[SLOT('c', 'p', 'e', 0, 0)] = INSN("cpe", 0xec, 3, ARG_IMM16, ARG_NONE, 0),
+	[SLOT('r', 'p', 0, 0, 0)] = INSN("rp", 0xf0, 1, ARG_NONE, ARG_NONE, 0),
+	[SLOT('j', 'p', 0, 0, 0)] = INSN("jp", 0xf2, 3, ARG_IMM16, ARG_NONE, 0),
+	[SLOT('c', 'p', 0, 0, 0)] = INSN("cp", 0xf4, 3, ARG_IMM16, ARG_NONE, 0),
+	[SLOT('r', 'm', 0, 0, 0)] = INSN("rm", 0xf8, 1, ARG_NONE, ARG_NONE, 0),
+	[SLOT('j', 'm', 0, 0, 0)] = INSN("jm", 0xfa, 3, ARG_IMM16, ARG_NONE, 0),
+	[SLOT('c', 'm', 0, 0, 0)] = INSN("cm", 0xfc, 3, ARG_IMM16, ARG_NONE, 0),
+	[SLOT('r', 's', 't', 0, 0)] = INSN("rst", 0xc7, 1, ARG_VECTOR, ARG_NONE, 3),
+	[SLOT('r', 'l', 'c', 0, 0)] = INSN("rlc", 0x07, 1, ARG_NONE, ARG_NONE, 0),
+	[SLOT('r', 'r', 'c', 0, 0)] = INSN("rrc", 0x0f, 1, ARG_NONE, ARG_NONE, 0),
+	[SLOT('r', 'a', 'l', 0, 0)] = INSN("ral", 0x17, 1, ARG_NONE, ARG_NONE, 0),
+	[SLOT('r', 'a', 'r', 0, 0)] = INSN("rar", 0x1f, 1, ARG_NONE, ARG_NONE, 0),
+	[SLOT('d', 'a', 'a', 0, 0)] = INSN("daa", 0x27, 1, ARG_NONE, ARG_NONE, 0),
+	[SLOT('c', 'm', 'a', 0, 0)] = INSN("cma", 0x2f, 1, ARG_NONE, ARG_NONE, 0),
+	[SLOT('s', 't', 'c', 0, 0)] = INSN("stc", 0x37, 1, ARG_NONE, ARG_NONE, 0),
+	[SLOT('c', 'm', 'c', 0, 0)] = INSN("cmc", 0x3f, 1, ARG_NONE, ARG_NONE, 0),
+	[SLOT('i', 'n', 'x', 0, 0)] = INSN("inx", 0x03, 1, ARG_PAIR, ARG_NONE, 4),
+	[SLOT('d', 'a', 'd', 0, 0)] = INSN("dad", 0x09, 1, ARG_PAIR, ARG_NONE, 4),
+	[SLOT('d', 'c', 'x', 0, 0)] = INSN("dcx", 0x0b, 1, ARG_PAIR, ARG_NONE, 4),
+	[SLOT('i', 'n', 'r', 0, 0)] = INSN("inr", 0x04, 1, ARG_REG, ARG_NONE, 3),
+	[SLOT('d', 'c', 'r', 0, 0)] = INSN("dcr", 0x05, 1, ARG_REG, ARG_NONE, 3),
+	[SLOT('s', 't', 'a', 'x', 0)] = INSN("stax", 0x02, 1, ARG_INDEX, ARG_NONE, 4),
+	[SLOT('l', 'd', 'a', 'x', 0)] = INSN("ldax", 0x0a, 1, ARG_INDEX, ARG_NONE, 4),
+	[SLOT('s', 'h', 'l', 'd', 0)] = INSN("shld", 0x22, 3, ARG_IMM16, ARG_NONE, 0),
+	[SLOT('l', 'h', 'l', 'd', 0)] = INSN("lhld", 0x2a, 3, ARG_IMM16, ARG_NONE, 0),
+	[SLOT('s', 't', 'a', 0, 0)] = INSN("sta", 0x32, 3, ARG_IMM16, ARG_NONE, 0),
+	[SLOT('l', 'd', 'a', 0, 0)] = INSN("lda", 0x3a, 3, ARG_IMM16, ARG_NONE, 0),
+	[SLOT('m', 'v', 'i', 0, 0)] = INSN("mvi", 0x06, 2, ARG_REG, ARG_IMM8, 3),
+	[SLOT('l', 'x', 'i', 0, 0)] = INSN("lxi", 0x01, 3, ARG_PAIR, ARG_IMM16, 4),
+	[SLOT('n', 'a', 'm', 'e', 0)] = DIRECTIVE("name", name),
+	[SLOT('t', 'i', 't', 'l', 'e')] = DIRECTIVE("title", title),
+	[SLOT('e', 'n', 'd', 0, 0)] = DIRECTIVE("end", end),
+	[SLOT('o', 'r', 'g', 0, 0)] = DIRECTIVE("org", org),
+	[SLOT('e', 'q', 'u', 0, 0)] = DIRECTIVE("equ", equ),
+	[SLOT('d', 'w', 0, 0, 0)] = DIRECTIVE("dw", dw),
+	[SLOT('d', 's', 0, 0, 0)] = DIRECTIVE("ds", ds),
+	[SLOT('d', 'b', 0, 0, 0)] = DIRECTIVE("db", db),
+	[SLOT('t', 'm', 'a', 'x', 0)] = DIRECTIVE("tmax", tmax),
+	[SLOT('r', 'o', 'o', 't', 0)] = DIRECTIVE("root", root),
+};
+
+static const struct mnemonic *
+findmnemonic(struct span t)
+{
+	unsigned long long key = 0;
+
+	if (t.len > 5) {
+		return NULL;
+	}
+	for (size_t i = 0; i < t.len; ++i) {
+		key |= (unsigned long long)(unsigned char)t.s[i] << (i * 8);
+	}
+
+	const struct mnemonic *m = &mnemonics[HASH(key)];
+	if (m->name == NULL || !speq(t, m->name)) {
+		return NULL;
+	}
+	return m;
+}
+
+/* Count the T-states of entry i against the open budget, if any. */
+static void
+spend(struct a80 *ctx, long i)
+{
+	if (ctx->budgeted && ctx->ir->opcode[i] >= 0
+			&& mnemonics[ctx->ir->op[i]].directive == NULL) {
+		ctx->spent += tstates[ctx->ir->opcode[i]];
+	}
+}
+
+static void
+encode(struct a80 *ctx, const struct mnemonic *m)
+{
+	struct span imm = { NULL, 0 };
+	int opcode = m->opcode;
+
+	assertarg(!ctx->operand1.s == (m->arg1 == ARG_NONE)
+			&& !ctx->operand2.s == (m->arg2 == ARG_NONE));
+
+	if (m->arg1 >= ARG_IMM8) {
+		imm = ctx->operand1;
+	} else if (m->arg1 != ARG_NONE) {
+		opcode |= field(ctx, m->arg1, ctx->operand1) << m->shift;
+	}
+	if (m->arg2 >= ARG_IMM8) {
+		imm = ctx->operand2;
+	} else if (m->arg2 != ARG_NONE) {
+		opcode |= field(ctx, m->arg2, ctx->operand2);
+	}
+
+	instr(ctx, m->size, opcode);
+	if (imm.s) {
+		immediate(ctx, entry(ctx), imm,
+				m->arg1 == ARG_IMM16 || m->arg2 == ARG_IMM16);
+	}
+}
+
+static void
+process(struct a80 *ctx)
+{
+	ctx->cur = -1;
+
+	if (!ctx->mnemonic.s && !ctx->operand1.s && !ctx->operand2.s) {
+		instr(ctx, 0, -1);
+		return;
+	}
+
+	const struct mnemonic *m = findmnemonic(ctx->mnemonic);
+	if (m == NULL) {
+		errmsg("unknown mnemonic: %.*s",
+				(int)ctx->mnemonic.len, ctx->mnemonic.s);
+	}
+	ctx->op = (unsigned char)(m - mnemonics);
+	++ctx->ndispatches;
+	if (m->directive != NULL) {
+		m->directive(ctx);
+	} else {
+		encode(ctx, m);
+	}
+
+	if (ctx->cur >= 0) {
+		ctx->ir->size[ctx->cur] = (unsigned short)(ctx->addr - ctx->ir->addr[ctx->cur]);
+		spend(ctx, ctx->cur);
+	}
+}
+
+static unsigned short
+symoperand(struct a80 *ctx, size_t i, size_t offset, unsigned char width)
+{
+	struct symbol *sym = &ctx->symtabs->syms[ctx->ir->arg[i]];
+
+	if (!sym->defined) {
+		struct fixup fixup = { offset, ctx->lineno, ctx->ir->arg[i], width };
+		if (irfixup(ctx->ir, fixup) < 0) {
+			errmsg("%s", "unable to allocate fixup");
+		}
+		return 0;
+	}
+	return sym->value;
+}
+
+/* Mark n bytes at at as written, noting whether any already were. */
+static void
+claim(struct a80 *ctx, size_t at, size_t n)
+{
+	for (size_t a = at; a < at + n; ++a) {
+		uint64_t bit = (uint64_t)1 << (a % 64);
+		if (ctx->used[a / 64] & bit) {
+			ctx->overlap = 1;
+		}
+		ctx->used[a / 64] |= bit;
+	}
+}
+
+/* Erase the object code of entry i from the output. */
+static void
+unplace(struct a80 *ctx, size_t i)
+{
+	size_t at = ctx->ir->addr[i];
+	size_t n = ctx->ir->size[i];
+
+	if (ctx->ir->kind[i] == IR_SPACE) {
+		return;
+	}
+	memset(ctx->output + at, 0, n);
+	for (size_t a = at; a < at + n; ++a) {
+		ctx->used[a / 64] &= ~((uint64_t)1 << (a % 64));
+	}
+}
+
+/* Copy n bytes of object code to the address of entry i. */
+static void
+place(struct a80 *ctx, size_t i, const unsigned char *code, size_t n)
+{
+	size_t at = ctx->ir->addr[i];
+
+	if (n == 0) {
+		return;
+	}
+	if (at + n > A80_IMAGESIZE) {
+		errmsg("%s", "object code exceeds 64 KB");
+	}
+	memcpy(ctx->output + at, code, n);
+	ctx->nemitted += n;
+	if (ctx->streaming) {
+		for (size_t a = at; a < at + n; ++a) {
+			ctx->writer[a] = ctx->lineno;
+		}
+	}
+	if (ctx->track) {
+		claim(ctx, at, n);
+	}
+
+	if (ctx->hi == 0 || at < ctx->lo) {
+		ctx->lo = at;
+	}
+	if (at + n > ctx->hi) {
+		ctx->hi = at + n;
+	}
+}
+
+static void
+emit(struct a80 *ctx, size_t i)
+{
+	unsigned char code[3];
+	size_t n = 0;
+	unsigned short num;
+
+	ctx->lineno = ctx->ir->lineno[i];
+
+	switch (ctx->ir->kind[i]) {
+	case IR_DATA:
+		place(ctx, i, ctx->ir->data + ctx->ir->arg[i], ctx->ir->size[i]);
+		return;
+	case IR_SPACE:
+		/* Reserved space is left as zeros and not written. */
+		return;
+	default:
+		break;
+	}
+
+	if (ctx->ir->opcode[i] >= 0) {
+		code[n++] = (unsigned char)ctx->ir->opcode[i];
+	}
+
+	switch (ctx->ir->kind[i]) {
+	case IR_IMM8:
+		code[n++] = (unsigned char)(ctx->ir->arg[i] & 0xff);
+		break;
+	case IR_IMM16:
+		code[n++] = (unsigned char)(ctx->ir->arg[i] & 0xff);
+		code[n++] = (unsigned char)((ctx->ir->arg[i] >> 8) & 0xff);
+		break;
+	case IR_SYM8:
+		num = symoperand(ctx, i, ctx->ir->addr[i] + n, 1);
+		code[n++] = (unsigned char)(num & 0xff);
+		break;
+	case IR_SYM16:
+		num = symoperand(ctx, i, ctx->ir->addr[i] + n, 2);
+		code[n++] = (unsigned char)(num & 0xff);
+		code[n++] = (unsigned char)((num >> 8) & 0xff);
+		break;
+	default:
+		break;
+	}
+
+	place(ctx, i, code, n);
+}
+
+/* Patch byte at of the output with its fixup, unless a later line wrote it. */
+static void
+patch(struct a80 *ctx, size_t at, const struct fixup *fixup, unsigned char byte)
+{
+	if (!ctx->streaming || ctx->writer[at] == fixup->lineno) {
+		ctx->output[at] = byte;
+	}
+}
+
+/*
+ * Patch each fixup with the value of its label. A label still undefined is
+ * reported at the first line to refer to it, however the fixups were
+ * ordered, as a80_reassemble() emits the lines it lexed again first.
+ */
+static void
+backpatch(struct a80 *ctx)
+{
+	const struct fixup *undefined = NULL;
+
+	for (size_t i = 0; i < ctx->ir->nfixups; ++i) {
+		struct fixup *fixup = &ctx->ir->fixups[i];
+		if (!ctx->symtabs->syms[fixup->sym].defined) {
+			if (undefined == NULL || fixup->lineno < undefined->lineno) {
+				undefined = fixup;
+			}
+			continue;
+		}
+
+		unsigned short num = ctx->symtabs->syms[fixup->sym].value;
+		patch(ctx, fixup->offset, fixup, (unsigned char)(num & 0xff));
+		if (fixup->width == 2) {
+			patch(ctx, fixup->offset + 1, fixup, (unsigned char)((num >> 8) & 0xff));
+		}
+	}
+	if (undefined != NULL) {
+		ctx->lineno = undefined->lineno;
+		symvalue(ctx, undefined->sym);
+	}
+}
+
+/*
+ * Opcodes the peephole pass looks for. A conditional jump or call has a
+ * condition in bits 3 to 5, and each opcode naming a pair has it in bits 4
+ * and 5.
+ */
+#define JMP 0xc3
+#define CALL 0xcd
+#define RET 0xc9
+#define XRAA 0xaf
+#define MVIA 0x3e
+#define ISJUMP(op) ((op) == JMP || ((op) & 0xc7) == 0xc2)
+#define ISCALL(op) ((op) == CALL || ((op) & 0xc7) == 0xc4)
+#define ISPUSH(op) (((op) & 0xcf) == 0xc5)
+
+#define PCHL 0xe9
+
+/* Bytes at the bottom of memory where rst jumps, which never move. */
+#define VECTORS 0x40
+
+enum {
+	MARK_LABEL = 1 << 0,	/* a label names the address of the entry */
+	MARK_ORG = 1 << 1,	/* an org sets the address of the entry */
+};
+
+/* What the optimizations know of the entries of pass 1. */
+struct layout {
+	unsigned char *marks;	/* of each entry, and of the end */
+	unsigned short *cut;	/* bytes cut from each entry */
+	long *symentry;		/* entry at the address of each label, or -1 */
+	int fixed;		/* whether code may not move */
+};
+
+/* Return whether entry i encodes an instruction rather than data. */
+static int
+isinsn(const struct ir *ir, size_t i)
+{
+	return ir->opcode[i] >= 0 && mnemonics[ir->op[i]].directive == NULL;
+}
+
+/* Return the first entry from i on that has object code, or -1. */
+static long
+live(const struct ir *ir, size_t i)
+{
+	for (; i < ir->len; ++i) {
+		if (ir->size[i] > 0 && ir->kind[i] != IR_SPACE) {
+			return (long)i;
+		}
+	}
+	return -1;
+}
+
+/*
+ * Return the entry whose bytes come straight after those of entry i, or -1
+ * if they are space from ds, or an org sends the entries after i elsewhere:
+ * what follows i in the source then does not follow it in memory.
+ */
+static long
+adjacent(const struct ir *ir, const struct layout *lay, size_t i)
+{
+	for (size_t j = i + 1; j < ir->len; ++j) {
+		if (lay->marks[j] & MARK_ORG) {
+			return -1;
+		}
+		if (ir->size[j] > 0) {
+			return ir->kind[j] == IR_SPACE ? -1 : (long)j;
+		}
+	}
+	return -1;
+}
+
+/*
+ * Return the entry after i that runs next, if nothing but falling through
+ * from i reaches it: no label or org names it or a dead entry before it.
+ */
+static long
+successor(const struct ir *ir, const struct layout *lay, size_t i)
+{
+	long j = adjacent(ir, lay, i);
+
+	for (size_t k = i + 1; j >= 0 && k <= (size_t)j; ++k) {
+		if (lay->marks[k]) {
+			return -1;
+		}
+	}
+	return j;
+}
+
+/*
+ * Return the entry of the instruction at the label that entry i jumps to,
+ * or -1 if its operand is not a label that names one.
+ */
+static long
+target(const struct a80 *ctx, const struct layout *lay, size_t i)
+{
+	const struct ir *ir = ctx->ir;
+
+	if (ir->kind[i] != IR_SYM16 || lay->symentry[ir->arg[i]] < 0) {
+		return -1;
+	}
+	long t = live(ir, lay->symentry[ir->arg[i]]);
+	if (t < 0 || !isinsn(ir, t)
+			|| ir->addr[t] != ctx->symtabs->syms[ir->arg[i]].value) {
+		return -1;
+	}
+	return t;
+}
+
+/*
+ * Return whether op neither reads nor writes the flags and always goes on
+ * to the next instruction: mov, mvi, lxi, inx, dcx, the loads and stores,
+ * push and pop of a pair other than psw, xchg, xthl, sphl, nop, in, out,
+ * di and ei.
+ */
+static int
+flagless(unsigned op)
+{
+	if ((op & 0xc0) == 0x40) {
+		return op != 0x76;
+	}
+	if ((op & 0xcb) == 0xc1) {
+		return (op & 0x30) != 0x30;
+	}
+	return (op & 0xc7) == 0x06 || (op & 0xcf) == 0x01 || (op & 0xc7) == 0x03
+		|| (op & 0xe7) == 0x02 || (op & 0xe7) == 0x22
+		|| op == 0xeb || op == 0xe3 || op == 0xf9 || op == 0x00
+		|| op == 0xdb || op == 0xd3 || op == 0xf3 || op == 0xfb;
+}
+
+/*
+ * Return whether the flags are written before they are read after entry i,
+ * looking past a few instructions that leave them alone.
+ */
+static int
+flagsdead(const struct ir *ir, const struct layout *lay, size_t i)
+{
+	for (int n = 0; n < 16; ++n) {
+		long j = adjacent(ir, lay, i);
+		if (j < 0 || !isinsn(ir, j)) {
+			return 0;
+		}
+
+		unsigned op = (unsigned)ir->opcode[j];
+		if ((op & 0xc0) == 0x80 || (op & 0xc7) == 0xc6) {
+			/* Every operation but adc, sbb and their immediates. */
+			return ((op >> 3) & 7) != 1 && ((op >> 3) & 7) != 3;
+		}
+		if (op == 0xf1) {
+			return 1;	/* pop psw */
+		}
+		if (!flagless(op)) {
+			return 0;
+		}
+		i = (size_t)j;
+	}
+	return 0;
+}
+
+/*
+ * Return whether the source names an address within its own object code
+ * by number, or by a label that equ gives a number, which moving that code
+ * would leave pointing elsewhere.
+ */
+static int
+numbered(const struct a80 *ctx, const struct layout *lay)
+{
+	const struct ir *ir = ctx->ir;
+	size_t lo = A80_IMAGESIZE, hi = 0;
+
+	for (size_t i = 0; i < ir->len; ++i) {
+		if (isinsn(ir, i) && ir->kind[i] != IR_SPACE) {
+			lo = ir->addr[i] < lo ? ir->addr[i] : lo;
+			hi = ir->addr[i] + ir->size[i] > hi ? ir->addr[i] + ir->size[i] : hi;
+		}
+	}
+	for (size_t i = 0; i < ir->len; ++i) {
+		unsigned long at;
+		if (isinsn(ir, i) && (ir->opcode[i] & 0xc7) == 0xc7) {
+			at = ir->opcode[i] & 0x38;	/* rst */
+		} else if (ir->kind[i] == IR_IMM16) {
+			at = ir->arg[i];
+		} else if (ir->kind[i] == IR_SYM16 && lay->symentry[ir->arg[i]] < 0) {
+			at = ctx->symtabs->syms[ir->arg[i]].value;
+		} else {
+			continue;
+		}
+		if (at >= lo && at < hi) {
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/* Count a rewrite that cut bytes from entry i and saved T-states. */
+static void
+saved(struct a80 *ctx, struct layout *lay, size_t i, size_t bytes, size_t t)
+{
+	++ctx->npeepholes;
+	ctx->nsavedbytes += bytes;
+	ctx->nsavedtstates += t;
+	lay->cut[i] += (unsigned short)bytes;
+}
+
+/* Drop entry i from the object code. */
+static void
+drop(struct ir *ir, size_t i)
+{
+	ir->kind[i] = IR_SPACE;
+	ir->size[i] = 0;
+}
+
+/*
+ * Rewrite the entries of pass 1 where a shorter or quicker sequence has the
+ * same effect:
+ *
+ *	jmp, call or a conditional one to a jmp	goes to where that jmp goes
+ *	call x; ret				becomes jmp x
+ *	jmp or a conditional jump to the next	is dropped
+ *	mvi a, 0 before the flags are written	becomes xra a
+ *	push p; pop p				is dropped
+ *
+ * A label or org between two instructions keeps them apart, since code
+ * elsewhere may jump to the second. Only the first rewrite leaves every
+ * address as it was, so it alone applies to a source that names an
+ * address within its own code by number rather than by label, or to code
+ * among the reset vectors. T-states saved are counted once for each
+ * rewritten sequence.
+ */
+static void
+peephole(struct a80 *ctx, struct layout *lay)
+{
+	struct ir *ir = ctx->ir;
+
+	for (size_t i = 0; i < ir->len; ++i) {
+		if (!isinsn(ir, i) || ir->kind[i] == IR_SPACE) {
+			continue;
+		}
+		unsigned op = (unsigned)ir->opcode[i];
+		long t, j;
+
+		if (ISJUMP(op) || ISCALL(op)) {
+			for (int hops = 0; hops < 16; ++hops) {
+				if ((t = target(ctx, lay, i)) < 0 || (size_t)t == i
+						|| ir->opcode[t] != JMP) {
+					break;
+				}
+				ir->kind[i] = ir->kind[t];
+				ir->arg[i] = ir->arg[t];
+				saved(ctx, lay, i, 0, tstates[JMP]);
+			}
+		}
+		if (lay->fixed || ir->addr[i] < VECTORS) {
+			continue;
+		}
+
+		if (op == CALL && (j = successor(ir, lay, i)) >= 0
+				&& ir->opcode[j] == RET && isinsn(ir, j)) {
+			ir->opcode[i] = JMP;
+			drop(ir, j);
+			saved(ctx, lay, j, 1, tstates[CALL] + tstates[RET] - tstates[JMP]);
+			continue;
+		}
+		if (ISJUMP(op) && (t = target(ctx, lay, i)) >= 0
+				&& t == adjacent(ir, lay, i)) {
+			drop(ir, i);
+			saved(ctx, lay, i, 3, tstates[op]);
+			continue;
+		}
+		if (op == MVIA && ir->kind[i] == IR_IMM8 && ir->arg[i] == 0
+				&& flagsdead(ir, lay, i)) {
+			ir->opcode[i] = XRAA;
+			ir->kind[i] = IR_NONE;
+			ir->size[i] = 1;
+			saved(ctx, lay, i, 1, tstates[MVIA] - tstates[XRAA]);
+			continue;
+		}
+		if (ISPUSH(op) && (j = successor(ir, lay, i)) >= 0
+				&& ir->opcode[j] == (short)(op - 4) && isinsn(ir, j)) {
+			drop(ir, i);
+			drop(ir, j);
+			saved(ctx, lay, i, 2, tstates[op] + tstates[op - 4]);
+		}
+	}
+}
+
+/* Return whether entry i never goes on to the entry after it. */
+static int
+final(const struct ir *ir, size_t i)
+{
+	return isinsn(ir, i) && (ir->opcode[i] == JMP || ir->opcode[i] == RET
+			|| ir->opcode[i] == PCHL);
+}
+
+/*
+ * Drop each block of entries, from one label or org to the next, that no
+ * code can reach. A block is reached from the start of the source, from a
+ * reset vector, from a root directive ahead of its first entry, from a
+ * block that refers to any of its labels, whether to jump, call or load,
+ * and from the block before it if that one can run into it. Nothing is
+ * dropped from a source that names an address within its own code by
+ * number, nor from among the reset vectors.
+ */
+static void
+prune(struct a80 *ctx, struct layout *lay)
+{
+	if (lay->fixed) {
+		return;
+	}
+
+	struct ir *ir = ctx->ir;
+	size_t n = ir->len;
+	size_t nsyms = ctx->symtabs->nsyms;
+	size_t cap = ctx->ndefs + 1;
+	size_t *starts = arenaalloc(&ctx->arena, cap * sizeof(size_t));
+	size_t *stack = arenaalloc(&ctx->arena, cap * sizeof(size_t));
+	long *symblock = arenaalloc(&ctx->arena, (nsyms + 1) * sizeof(long));
+	unsigned char *orged = arenaalloc(&ctx->arena, cap);
+	unsigned char *reached = arenaalloc(&ctx->arena, cap);
+	size_t nblocks = 1, sp = 0;
+	int rooted = 0;
+
+	if (starts == NULL || stack == NULL || symblock == NULL
+			|| orged == NULL || reached == NULL) {
+		errmsg("%s", "unable to allocate memory");
+	}
+	memset(orged, 0, cap);
+	memset(reached, 0, cap);
+	for (size_t k = 0; k < nsyms; ++k) {
+		symblock[k] = -1;
+	}
+
+#define REACH(b) \
+	do { \
+		if (!reached[b]) { \
+			reached[b] = 1; \
+			stack[sp++] = (b); \
+		} \
+	} while (0)
+
+	/*
+	 * Number the blocks in the order their first label or org appears. A
+	 * root before the first entry of a block marks that block, and one
+	 * after it the block that starts next.
+	 */
+	starts[0] = 0;
+	REACH(0);
+	for (size_t d = 0; d < ctx->ndefs; ++d) {
+		const struct def *def = &ctx->defs[d];
+		if (def->sym == ROOTDEF) {
+			if (def->entry == starts[nblocks - 1]) {
+				REACH(nblocks - 1);
+			} else {
+				rooted = 1;
+			}
+			continue;
+		}
+		if (def->sym != ORGDEF && !def->relative) {
+			continue;
+		}
+		if (def->entry > starts[nblocks - 1]) {
+			starts[nblocks++] = def->entry;
+			if (rooted) {
+				REACH(nblocks - 1);
+				rooted = 0;
+			}
+		}
+		if (def->sym == ORGDEF) {
+			orged[nblocks - 1] = 1;
+		} else {
+			symblock[def->sym] = (long)(nblocks - 1);
+		}
+		if (def->value < VECTORS && def->value % 8 == 0) {
+			REACH(nblocks - 1);
+		}
+	}
+
+	while (sp > 0) {
+		size_t b = stack[--sp];
+		size_t end = b + 1 < nblocks ? starts[b + 1] : n;
+		long last = -1;
+
+		for (size_t i = starts[b]; i < end; ++i) {
+			if ((ir->kind[i] == IR_SYM8 || ir->kind[i] == IR_SYM16)
+					&& symblock[ir->arg[i]] >= 0) {
+				REACH((size_t)symblock[ir->arg[i]]);
+			}
+			if (live(ir, i) == (long)i) {
+				last = (long)i;
+			}
+		}
+		if (b + 1 < nblocks && !orged[b + 1] && (last < 0 || !final(ir, last))) {
+			REACH(b + 1);
+		}
+	}
+#undef REACH
+
+	for (size_t b = 0; b < nblocks; ++b) {
+		size_t end = b + 1 < nblocks ? starts[b + 1] : n;
+		size_t bytes = 0;
+
+		for (size_t i = starts[b]; i < end && !reached[b]; ++i) {
+			reached[b] = ir->addr[i] < VECTORS;
+		}
+		if (reached[b]) {
+			continue;
+		}
+		for (size_t i = starts[b]; i < end; ++i) {
+			bytes += ir->size[i];
+			lay->cut[i] += ir->size[i];
+			drop(ir, i);
+		}
+		if (bytes > 0) {
+			++ctx->npruned;
+			ctx->nprunedbytes += bytes;
+		}
+	}
+}
+
+/* Move each entry and label back by the bytes cut before it. */
+static void
+relocate(struct a80 *ctx, const struct layout *lay)
+{
+	struct ir *ir = ctx->ir;
+	unsigned short addr = 0, delta = 0;
+	size_t d = 0;
+
+	for (size_t i = 0; i <= ir->len; ++i) {
+		for (; d < ctx->ndefs && ctx->defs[d].entry <= i; ++d) {
+			const struct def *def = &ctx->defs[d];
+			if (def->sym == ORGDEF) {
+				addr = def->value;
+				delta = 0;
+			} else if (def->sym != ROOTDEF && def->relative) {
+				ctx->symtabs->syms[def->sym].value = applyop(
+						def->value - delta, def->op, def->rhs);
+			}
+		}
+		if (i < ir->len) {
+			ir->addr[i] = addr;
+			addr += ir->size[i];
+			delta += lay->cut[i];
+		}
+	}
+}
+
+/*
+ * Apply the optimizations asked for by a80_setoptimize() to the entries of
+ * pass 1, then close the gaps they leave.
+ */
+static void
+optimize(struct a80 *ctx)
+{
+	struct ir *ir = ctx->ir;
+	size_t n = ir->len;
+	size_t nsyms = ctx->symtabs->nsyms;
+	struct layout lay = {
+		arenaalloc(&ctx->arena, n + 1),
+		arenaalloc(&ctx->arena, (n + 1) * sizeof(unsigned short)),
+		arenaalloc(&ctx->arena, (nsyms + 1) * sizeof(long)),
+		0,
+	};
+
+	if (lay.marks == NULL || lay.cut == NULL || lay.symentry == NULL) {
+		errmsg("%s", "unable to allocate memory");
+	}
+	memset(lay.marks, 0, n + 1);
+	memset(lay.cut, 0, (n + 1) * sizeof(unsigned short));
+	for (size_t k = 0; k < nsyms; ++k) {
+		lay.symentry[k] = -1;
+	}
+	for (size_t d = 0; d < ctx->ndefs; ++d) {
+		const struct def *def = &ctx->defs[d];
+		if (def->sym == ORGDEF) {
+			lay.marks[def->entry] |= MARK_ORG;
+		} else if (def->sym != ROOTDEF && def->relative) {
+			lay.marks[def->entry] |= MARK_LABEL;
+			lay.symentry[def->sym] = (long)def->entry;
+		}
+	}
+	lay.fixed = numbered(ctx, &lay);
+
+	if (ctx->optimizing & A80_PRUNE) {
+		prune(ctx, &lay);
+	}
+	if (ctx->optimizing & A80_PEEPHOLE) {
+		peephole(ctx, &lay);
+	}
+	if (ctx->nsavedbytes > 0 || ctx->nprunedbytes > 0) {
+		relocate(ctx, &lay);
+	}
+}
+
+static double
+now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint64_t
+hashline(const char *s, size_t n)
+{
+	uint64_t h = n * 0x9e3779b97f4a7c15ULL;
+	uint64_t w;
+
+	for (; n >= 8; s += 8, n -= 8) {
+		memcpy(&w, s, 8);
+		h = (h ^ w) * 0xff51afd7ed558ccdULL;
+		h ^= h >> 32;
+	}
+	if (n > 0) {
+		w = 0;
+		memcpy(&w, s, n);
+		h = (h ^ w) * 0xc4ceb9fe1a85ec53ULL;
+	}
+	return h ^ (h >> 29);
+}
+
+/*
+ * Reproduce the entry of a line of identical text seen earlier in this
+ * assembly, if there was one, sparing it parse() and process().
+ */
+static int
+recall(struct a80 *ctx, const char *s, size_t n, uint64_t hash)
+{
+	const struct memo *memo = &ctx->memo[hash & (NMEMO - 1)];
+
+	if (memo->gen != ctx->memogen || memo->hash != hash || memo->len != n
+			|| memcmp(memo->s, s, n) != 0) {
+		++ctx->nforgotten;
+		return 0;
+	}
+
+	ctx->op = memo->op;
+	ctx->cur = -1;
+	long i = entry(ctx);
+	ctx->ir->opcode[i] = memo->opcode;
+	ctx->ir->kind[i] = memo->kind;
+	ctx->ir->arg[i] = memo->arg;
+	ctx->ir->size[i] = memo->size;
+	ctx->addr += memo->size;
+	spend(ctx, i);
+	++ctx->nrecalled;
+	return 1;
+}
+
+/* Remember the entry of the line just processed if nothing else came of it. */
+static void
+memoize(struct a80 *ctx, const char *s, size_t n, uint64_t hash)
+{
+	long i = ctx->cur;
+
+	if (i < 0 || ctx->label.s || ctx->lineflags != 0) {
+		return;
+	}
+	switch (ctx->ir->kind[i]) {
+	case IR_NONE:
+	case IR_IMM8:
+	case IR_IMM16:
+	case IR_SPACE:
+		break;
+	default:
+		return;
+	}
+
+	ctx->memo[hash & (NMEMO - 1)] = (struct memo){
+		s, n, hash, ctx->memogen, ctx->ir->arg[i], ctx->ir->opcode[i],
+		ctx->ir->size[i], ctx->ir->op[i], ctx->ir->kind[i],
+	};
+}
+
+/*
+ * Lex and process the n characters at offset pos of buf, recording what the
+ * line produced when the source is to stay resident.
+ */
+static void
+lexline(struct a80 *ctx, const char *buf, size_t pos, size_t n,
+		const struct lexmask *m)
+{
+	unsigned short start = ctx->addr;
+	uint64_t hash = 0;
+
+	ctx->defsym = -1;
+	ctx->lineflags = 0;
+	if (ctx->memo != NULL) {
+		hash = hashline(buf + pos, n);
+	}
+	if (ctx->memo == NULL || !recall(ctx, buf + pos, n, hash)) {
+		parse(ctx, buf + pos, n, m);
+		process(ctx);
+		if (ctx->memo != NULL) {
+			memoize(ctx, buf + pos, n, hash);
+		}
+	}
+
+	if (!ctx->track) {
+		return;
+	}
+	if (ctx->nlines == ctx->linescap) {
+		size_t cap = ctx->linescap ? ctx->linescap * 2 : 1024;
+		struct lineinfo *lines = realloc(ctx->lines, cap * sizeof(*lines));
+		if (lines == NULL) {
+			errmsg("%s", "unable to allocate line");
+		}
+		ctx->lines = lines;
+		ctx->linescap = cap;
+	}
+	ctx->lines[ctx->nlines++] = (struct lineinfo){
+		pos, ctx->cur, ctx->defsym, start, ctx->addr, ctx->lineflags,
+	};
+}
+
+static void
+assemble(struct a80 *ctx, const char *buf, size_t len)
+{
+	struct lexer lx;
+	struct lexmask m;
+	int masked;
+	double start = now();
+
+	/* Lex each line once, recording the address of label declarations. */
+	initlexer(&lx, buf, len);
+	for (size_t pos = 0; pos < len; ) {
+		size_t n = nextline(&lx, pos, &m, &masked);
+
+		++ctx->lineno;
+		lexline(ctx, buf, pos, n, masked ? &m : NULL);
+
+		pos += n + 1;
+	}
+	endbudget(ctx);
+	if (ctx->optimizing) {
+		optimize(ctx);
+	}
+	ctx->pass1 = now() - start;
+
+	/* Generate object code. */
+	start = now();
+	for (size_t i = 0; i < ctx->ir->len; ++i) {
+		emit(ctx, i);
+	}
+	backpatch(ctx);
+	ctx->pass2 = now() - start;
+}
+
+/*
+ * Emit the object code of each line as soon as it is lexed, leaving a fixup
+ * for every reference to a label not yet defined. Only the current line is
+ * held in memory. Where an org sends a later line over the operand of a
+ * fixup, the later line keeps its bytes, as it would in two passes.
+ */
+static void
+assemble1(struct a80 *ctx, FILE *istream)
+{
+	ssize_t nread;
+	double start = now();
+
+	if (ctx->writer == NULL
+			&& (ctx->writer = malloc(A80_IMAGESIZE * sizeof(size_t))) == NULL) {
+		errmsg("%s", "unable to allocate memory");
+	}
+	ctx->streaming = 1;
+	while ((nread = getline(&ctx->line, &ctx->linecap, istream)) != -1) {
+		++ctx->lineno;
+		ctx->lineflags = 0;
+		parse(ctx, ctx->line, nread, NULL);
+		process(ctx);
+
+		for (size_t i = 0; i < ctx->ir->len; ++i) {
+			emit(ctx, i);
+		}
+		ctx->ir->len = 0;
+		ctx->ir->ndata = 0;
+	}
+	endbudget(ctx);
+	ctx->pass1 = now() - start;
+
+	start = now();
+	backpatch(ctx);
+	ctx->pass2 = now() - start;
+}
+
+struct a80 *
+a80_new(void)
+{
+	return calloc(1, sizeof(struct a80));
+}
+
+/*
+ * Lex sources of at least twice CHUNKMIN bytes with up to n threads. One
+ * thread, the default, lexes every source in order.
+ */
+void
+a80_setthreads(struct a80 *ctx, size_t n)
+{
+	ctx->nthreads = n;
+}
+
+/*
+ * Have a80_assemble() apply the optimizations in flags: A80_PEEPHOLE to
+ * rewrite wasteful sequences of instructions, as listed at peephole(), and
+ * A80_PRUNE to drop code that nothing reaches, as prune() does. Sources
+ * are then lexed by one thread.
+ */
+void
+a80_setoptimize(struct a80 *ctx, int flags)
+{
+	ctx->optimize = flags;
+}
+
+void
+a80_free(struct a80 *ctx)
+{
+	freearena(&ctx->arena);
+	free(ctx->line);
+	free(ctx->writer);
+	free(ctx->src);
+	free(ctx->lines);
+	free(ctx->moved);
+	free(ctx->marks);
+	free(ctx->memo);
+	for (size_t k = 0; k < ctx->chunkscap; ++k) {
+		if (ctx->chunks[k].ctx != NULL) {
+			a80_free(ctx->chunks[k].ctx);
+		}
+		free(ctx->chunks[k].map);
+	}
+	free(ctx->chunks);
+	free(ctx->defs);
+	free(ctx);
+}
+
+/* Forget everything about the last assembly but its object code. */
+static int
+reset(struct a80 *ctx)
+{
+	arenareset(&ctx->arena);
+	ctx->symtabs = initsymtab(&ctx->arena);
+	ctx->ir = initir(&ctx->arena);
+	if (ctx->memo == NULL) {
+		ctx->memo = calloc(NMEMO, sizeof(struct memo));
+	}
+	++ctx->memogen;
+	ctx->addr = 0;
+	ctx->lo = 0;
+	ctx->hi = 0;
+	ctx->lineno = 0;
+	ctx->cur = -1;
+	ctx->track = 0;
+	ctx->resident = 0;
+	ctx->streaming = 0;
+	ctx->nchunks = 0;
+	ctx->chunked = 0;
+	ctx->orged = 0;
+	ctx->ndefs = 0;
+	ctx->budgeted = 0;
+	ctx->nbudgets = 0;
+	ctx->optimizing = 0;
+	ctx->npeepholes = 0;
+	ctx->nsavedbytes = 0;
+	ctx->nsavedtstates = 0;
+	ctx->npruned = 0;
+	ctx->nprunedbytes = 0;
+	ctx->nrecalled = 0;
+	ctx->nforgotten = 0;
+	ctx->nsymbols = 0;
+	ctx->ndispatches = 0;
+	ctx->nemitted = 0;
+	ctx->pass1 = 0;
+	ctx->pass2 = 0;
+	ctx->errline = 0;
+	ctx->err[0] = '\0';
+
+	if (ctx->symtabs == NULL || ctx->ir == NULL) {
+		snprintf(ctx->err, sizeof(ctx->err), "%s", "unable to allocate memory");
+		return -1;
+	}
+	return 0;
+}
+
+static int
+begin(struct a80 *ctx, struct a80_image *out)
+{
+	ctx->output = out->bytes;
+	memset(ctx->output, 0, A80_IMAGESIZE);
+	return reset(ctx);
+}
+
+static void
+finish(struct a80 *ctx, struct a80_image *out)
+{
+	out->lo = ctx->lo;
+	out->hi = ctx->hi;
+}
+
+/* Lex chunk i with a context of its own, keeping any error for merge(). */
+static void
+lexchunk(void *arg, size_t worker, size_t i)
+{
+	struct chunk *chunk = &((struct a80 *)arg)->chunks[i];
+	struct a80 *sub = chunk->ctx;
+	struct lexer lx;
+	struct lexmask m;
+	int masked;
+
+	(void)worker;
+	chunk->failed = 1;
+	if (reset(sub) != 0) {
+		return;
+	}
+	if (setjmp(sub->env) != 0) {
+		return;
+	}
+	sub->chunked = 1;
+
+	initlexer(&lx, chunk->buf, chunk->len);
+	for (size_t pos = 0; pos < chunk->len; ) {
+		size_t n = nextline(&lx, pos, &m, &masked);
+
+		++sub->lineno;
+		lexline(sub, chunk->buf, pos, n, masked ? &m : NULL);
+
+		pos += n + 1;
+	}
+	if (!sub->orged) {
+		sub->relentries = sub->ir->len;
+	}
+	chunk->failed = 0;
+}
+
+/*
+ * Place each chunk after the one before it, with an org in a chunk fixing
+ * where the next begins, and merge the labels each defines into the
+ * symbols of ctx. Labels are merged in the order the source defines them,
+ * and a chunk that failed stops the merge at its error, so the error
+ * reported is the first a sequential pass would have met.
+ */
+static void
+merge(struct a80 *ctx)
+{
+	size_t lines = 0;
+
+	for (size_t k = 0; k < ctx->nchunks; ++k) {
+		struct chunk *chunk = &ctx->chunks[k];
+		struct a80 *sub = chunk->ctx;
+		struct symtab *local = sub->symtabs;
+		size_t nsyms = local ? local->nsyms : 0;
+		size_t stop = chunk->failed ? sub->errline : (size_t)-1;
+
+		chunk->firstline = lines;
+		chunk->base = ctx->addr;
+		if (nsyms > chunk->mapcap) {
+			long *map = realloc(chunk->map, nsyms * sizeof(*map));
+			if (map == NULL) {
+				errmsg("%s", "unable to allocate symbol");
+			}
+			chunk->map = map;
+			chunk->mapcap = nsyms;
+		}
+		for (size_t i = 0; i < nsyms; ++i) {
+			chunk->map[i] = -1;
+		}
+
+		for (size_t d = 0; d < sub->ndefs && sub->defs[d].lineno < stop; ++d) {
+			struct def *def = &sub->defs[d];
+			const char *label = local->syms[def->sym].label;
+
+			ctx->lineno = lines + def->lineno;
+			long id = intern(ctx->symtabs, label, strlen(label));
+			if (id < 0) {
+				errmsg("%s", "unable to allocate symbol");
+			}
+			struct symbol *sym = &ctx->symtabs->syms[id];
+			if (sym->defined) {
+				errmsg("duplicate label %s", label);
+			}
+			sym->value = def->relative
+				? applyop(chunk->base + def->value, def->op, def->rhs)
+				: local->syms[def->sym].value;
+			sym->defined = 1;
+			chunk->map[def->sym] = id;
+		}
+		if (chunk->failed) {
+			snprintf(ctx->err, sizeof(ctx->err), "%s", sub->err);
+			ctx->errline = sub->errline ? lines + sub->errline : 0;
+			longjmp(ctx->env, 1);
+		}
+
+		/* Symbols only referred to within the chunk. */
+		for (size_t i = 0; i < nsyms; ++i) {
+			if (chunk->map[i] < 0) {
+				const char *label = local->syms[i].label;
+				if ((chunk->map[i] = intern(ctx->symtabs, label, strlen(label))) < 0) {
+					errmsg("%s", "unable to allocate symbol");
+				}
+			}
+		}
+
+		ctx->addr = sub->orged ? sub->addr : (unsigned short)(ctx->addr + sub->addr);
+		lines += sub->lineno;
+		ctx->nrecalled += sub->nrecalled;
+		ctx->nforgotten += sub->nforgotten;
+		ctx->nsymbols += sub->nsymbols;
+		ctx->ndispatches += sub->ndispatches;
+		ctx->nbudgets += sub->nbudgets;
+		ctx->symtabs->nlookups += local->nlookups;
+		ctx->symtabs->nprobes += local->nprobes;
+	}
+	ctx->lineno = lines;
+}
+
+/* Rebase the entries of chunk i and refer them to the merged symbols. */
+static void
+rebase(void *arg, size_t worker, size_t i)
+{
+	struct chunk *chunk = &((struct a80 *)arg)->chunks[i];
+	struct a80 *sub = chunk->ctx;
+	struct ir *ir = sub->ir;
+
+	(void)worker;
+	chunk->lo = A80_IMAGESIZE;
+	chunk->hi = 0;
+	for (size_t e = 0; e < ir->len; ++e) {
+		if (ir->kind[e] == IR_SYM8 || ir->kind[e] == IR_SYM16) {
+			ir->arg[e] = (unsigned long)chunk->map[ir->arg[e]];
+		}
+		if (e < sub->relentries) {
+			ir->addr[e] += chunk->base;
+		}
+		ir->lineno[e] += chunk->firstline;
+
+		if (ir->kind[e] != IR_SPACE && ir->size[e] > 0) {
+			size_t at = ir->addr[e];
+			if (at < chunk->lo) {
+				chunk->lo = at;
+			}
+			if (at + ir->size[e] > chunk->hi) {
+				chunk->hi = at + ir->size[e];
+			}
+		}
+	}
+}
+
+/*
+ * Emit the entries of chunk i straight into the output through the chunk's
+ * own context, looking up the merged symbols, which no longer change.
+ */
+static void
+emitchunk(void *arg, size_t worker, size_t i)
+{
+	struct a80 *ctx = arg;
+	struct chunk *chunk = &ctx->chunks[i];
+	struct a80 *sub = chunk->ctx;
+
+	(void)worker;
+	chunk->failed = 1;
+	sub->output = ctx->output;
+	sub->symtabs = ctx->symtabs;
+	sub->lo = 0;
+	sub->hi = 0;
+	sub->nemitted = 0;
+	if (setjmp(sub->env) != 0) {
+		return;
+	}
+
+	for (size_t e = 0; e < sub->ir->len; ++e) {
+		emit(sub, e);
+	}
+	chunk->failed = 0;
+}
+
+/* Whether the object code of no two chunks could land on the same byte. */
+static int
+disjoint(const struct a80 *ctx)
+{
+	for (size_t j = 0; j < ctx->nchunks; ++j) {
+		for (size_t k = j + 1; k < ctx->nchunks; ++k) {
+			const struct chunk *a = &ctx->chunks[j], *b = &ctx->chunks[k];
+			if (a->lo < a->hi && b->lo < b->hi && a->lo < b->hi && b->lo < a->hi) {
+				return 0;
+			}
+		}
+	}
+	return 1;
+}
+
+/*
+ * Emit every chunk concurrently, each into its own range of the output.
+ * The first error in source order is the one reported, as though the
+ * chunks had been emitted one after another.
+ */
+static void
+emitchunks(struct a80 *ctx, size_t nworkers)
+{
+	parallelfor(nworkers, ctx->nchunks, emitchunk, ctx);
+
+	for (size_t k = 0; k < ctx->nchunks; ++k) {
+		struct a80 *sub = ctx->chunks[k].ctx;
+
+		if (ctx->chunks[k].failed) {
+			snprintf(ctx->err, sizeof(ctx->err), "%s", sub->err);
+			ctx->errline = sub->errline;
+			longjmp(ctx->env, 1);
+		}
+		if (sub->hi > 0 && (ctx->hi == 0 || sub->lo < ctx->lo)) {
+			ctx->lo = sub->lo;
+		}
+		if (sub->hi > ctx->hi) {
+			ctx->hi = sub->hi;
+		}
+		ctx->nemitted += sub->nemitted;
+	}
+}
+
+/*
+ * As assemble(), but with the lines split into nchunks pieces that are
+ * lexed concurrently. Each piece is lexed as though it began at address
+ * zero; a prefix sum over the sizes of the pieces then places them.
+ */
+static void
+assemblechunks(struct a80 *ctx, const char *buf, size_t len, size_t nchunks)
+{
+	struct ir *ir = ctx->ir;
+	size_t nworkers = ctx->nthreads < nchunks ? ctx->nthreads : nchunks;
+	double start = now();
+
+	if (nchunks > ctx->chunkscap) {
+		struct chunk *chunks = realloc(ctx->chunks, nchunks * sizeof(*chunks));
+		if (chunks == NULL) {
+			errmsg("%s", "unable to allocate memory");
+		}
+		memset(chunks + ctx->chunkscap, 0, (nchunks - ctx->chunkscap) * sizeof(*chunks));
+		ctx->chunks = chunks;
+		ctx->chunkscap = nchunks;
+	}
+
+	/* Split at the first line boundary after each equal share. */
+	size_t pos = 0;
+	for (size_t k = 0; k < nchunks; ++k) {
+		struct chunk *chunk = &ctx->chunks[k];
+		size_t end = len;
+
+		if (chunk->ctx == NULL && (chunk->ctx = a80_new()) == NULL) {
+			errmsg("%s", "unable to allocate memory");
+		}
+		if (k + 1 < nchunks && len / nchunks * (k + 1) > pos) {
+			const char *nl = memchr(buf + len / nchunks * (k + 1), '\n',
+					len - len / nchunks * (k + 1));
+			end = nl ? (size_t)(nl - buf) + 1 : len;
+		} else if (k + 1 < nchunks) {
+			end = pos;
+		}
+		chunk->buf = buf + pos;
+		chunk->len = end - pos;
+		pos = end;
+	}
+	ctx->nchunks = nchunks;
+
+	parallelfor(nworkers, nchunks, lexchunk, ctx);
+	merge(ctx);
+	parallelfor(nworkers, nchunks, rebase, ctx);
+	ctx->pass1 = now() - start;
+
+	/*
+	 * Generate object code, concurrently unless an org sends one chunk
+	 * over bytes of another, where the later line must win.
+	 */
+	start = now();
+	if (disjoint(ctx)) {
+		emitchunks(ctx, nworkers);
+	} else {
+		for (size_t k = 0; k < nchunks; ++k) {
+			ctx->ir = ctx->chunks[k].ctx->ir;
+			for (size_t i = 0; i < ctx->ir->len; ++i) {
+				emit(ctx, i);
+			}
+		}
+	}
+	for (size_t k = 0; k < nchunks; ++k) {
+		ctx->ir = ctx->chunks[k].ctx->ir;
+		backpatch(ctx);
+	}
+	ctx->ir = ir;
+	ctx->pass2 = now() - start;
+}
+
+/*
+ * Assemble the len bytes of source at buf into out. Return 0 on success, or
+ * -1 with the diagnosis available from a80_error() and a80_errline().
+ */
+int
+a80_assemble(struct a80 *ctx, const char *buf, size_t len, struct a80_image *out)
+{
+	if (begin(ctx, out) != 0) {
+		return -1;
+	}
+	if (setjmp(ctx->env) != 0) {
+		return -1;
+	}
+
+	if (ctx->nthreads > 1 && len >= 2 * CHUNKMIN && !ctx->optimize) {
+		size_t nchunks = len / CHUNKMIN;
+		assemblechunks(ctx, buf, len,
+				nchunks < ctx->nthreads ? nchunks : ctx->nthreads);
+	} else {
+		ctx->optimizing = ctx->optimize;
+		assemble(ctx, buf, len);
+	}
+
+	/* The block of a tmax may run from one chunk into the next. */
+	if (ctx->nchunks > 0 && ctx->nbudgets > 0) {
+		if (begin(ctx, out) != 0) {
+			return -1;
+		}
+		assemble(ctx, buf, len);
+	}
+	finish(ctx, out);
+
+	return 0;
+}
+
+/* As a80_assemble(), but in a single pass over lines read from stream. */
+int
+a80_assemblestream(struct a80 *ctx, FILE *stream, struct a80_image *out)
+{
+	if (begin(ctx, out) != 0) {
+		return -1;
+	}
+	if (setjmp(ctx->env) != 0) {
+		return -1;
+	}
+
+	assemble1(ctx, stream);
+	finish(ctx, out);
+
+	return 0;
+}
+
+/* Return the length of the common prefix of the n bytes at a and b. */
+static size_t
+prefix(const char *a, const char *b, size_t n)
+{
+	size_t i = 0;
+
+	while (n - i >= 64 && memcmp(a + i, b + i, 64) == 0) {
+		i += 64;
+	}
+	while (i < n && a[i] == b[i]) {
+		++i;
+	}
+	return i;
+}
+
+/* Return the length, at most n, of the common suffix of sources ending at a and b. */
+static size_t
+suffix(const char *a, const char *b, size_t n)
+{
+	size_t i = 0;
+
+	while (n - i >= 64 && memcmp(a - i - 64, b - i - 64, 64) == 0) {
+		i += 64;
+	}
+	while (i < n && a[-1 - (long)i] == b[-1 - (long)i]) {
+		++i;
+	}
+	return i;
+}
+
+/* Return the index of the first resident line that starts after offset. */
+static size_t
+firstafter(const struct a80 *ctx, size_t offset)
+{
+	size_t lo = 0, hi = ctx->nlines;
+
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		if (ctx->lines[mid].offset > offset) {
+			hi = mid;
+		} else {
+			lo = mid + 1;
+		}
+	}
+	return lo;
+}
+
+/* Remember that the value of symbol id changed in this update. */
+static void
+moved(struct a80 *ctx, unsigned long id)
+{
+	if (ctx->nmoved == ctx->movedcap) {
+		size_t cap = ctx->movedcap ? ctx->movedcap * 2 : 64;
+		unsigned long *p = realloc(ctx->moved, cap * sizeof(*p));
+		if (p == NULL) {
+			errmsg("%s", "unable to allocate symbol");
+		}
+		ctx->moved = p;
+		ctx->movedcap = cap;
+	}
+	ctx->moved[ctx->nmoved++] = id;
+}
+
+/* Emit again every entry that refers to a symbol whose value changed. */
+static void
+rebind(struct a80 *ctx)
+{
+	struct ir *ir = ctx->ir;
+	size_t nsyms = ctx->symtabs->nsyms;
+
+	if (nsyms > ctx->markscap) {
+		unsigned char *p = realloc(ctx->marks, nsyms);
+		if (p == NULL) {
+			errmsg("%s", "unable to allocate symbol");
+		}
+		ctx->marks = p;
+		ctx->markscap = nsyms;
+	}
+	memset(ctx->marks, 0, nsyms);
+	for (size_t i = 0; i < ctx->nmoved; ++i) {
+		ctx->marks[ctx->moved[i]] = 1;
+	}
+
+	for (size_t i = 0; i < ir->len; ++i) {
+		if ((ir->kind[i] == IR_SYM8 || ir->kind[i] == IR_SYM16)
+				&& ctx->marks[ir->arg[i]]) {
+			unplace(ctx, i);
+			emit(ctx, i);
+		}
+	}
+}
+
+/* Recompute the range of addresses written from the bytes in use. */
+static void
+bounds(struct a80 *ctx)
+{
+	size_t nwords = A80_IMAGESIZE / 64;
+
+	ctx->lo = 0;
+	ctx->hi = 0;
+	for (size_t w = 0; w < nwords; ++w) {
+		if (ctx->used[w]) {
+			ctx->lo = w * 64 + __builtin_ctzll(ctx->used[w]);
+			break;
+		}
+	}
+	for (size_t w = nwords; w-- > 0; ) {
+		if (ctx->used[w]) {
+			ctx->hi = w * 64 + 64 - __builtin_clzll(ctx->used[w]);
+			break;
+		}
+	}
+}
+
+/*
+ * Bring the resident assembly up to date with buf, a revision of its
+ * source. Lines common to the start and end of both revisions are kept and
+ * those between them are lexed again. Addresses after the edit shift by the
+ * change in size until an org sets them outright, so only the object code
+ * that moved, or that refers to a symbol whose value changed, is emitted
+ * again.
+ */
+static void
+update(struct a80 *ctx, const char *buf, size_t len)
+{
+	struct ir *ir = ctx->ir;
+	struct lexer lx;
+	struct lexmask m;
+	int masked;
+	double start = now();
+
+	size_t nold = ctx->nlines;
+	size_t shorter = len < ctx->srclen ? len : ctx->srclen;
+	size_t p = prefix(ctx->src, buf, shorter);
+	size_t q = suffix(ctx->src + ctx->srclen, buf + len, shorter - p);
+	size_t lastend = ctx->srclen > 0 && ctx->src[ctx->srclen - 1] == '\n'
+		? ctx->srclen : ctx->srclen + 1;
+
+	/* Keep the lines, newline and all, within the common prefix and suffix. */
+	size_t nprefix = 0, nsuffix = 0;
+	if (nold > 0) {
+		nprefix = firstafter(ctx, p) - 1 + (lastend <= p);
+		nsuffix = nold - firstafter(ctx, ctx->srclen - q);
+		if (nsuffix > nold - nprefix) {
+			nsuffix = nold - nprefix;
+		}
+	}
+	size_t oldsuffix = nold - nsuffix;
+	size_t from = nprefix < nold ? ctx->lines[nprefix].offset : ctx->srclen;
+	size_t to = nsuffix > 0 ? ctx->lines[oldsuffix].offset + len - ctx->srclen : len;
+
+	/* Withdraw what the replaced lines produced. */
+	++ctx->memogen;
+	ctx->nmoved = 0;
+	for (size_t i = nprefix; i < oldsuffix; ++i) {
+		struct lineinfo *li = &ctx->lines[i];
+		if (li->entry >= 0) {
+			unplace(ctx, li->entry);
+			ir->kind[li->entry] = IR_SPACE;
+			ir->size[li->entry] = 0;
+			++ctx->ndead;
+		}
+		if (li->sym >= 0) {
+			ctx->symtabs->syms[li->sym].defined = 0;
+			moved(ctx, li->sym);
+		}
+	}
+
+	size_t nnew = 0;
+	for (size_t pos = from; pos < to; ++nnew) {
+		const char *nl = memchr(buf + pos, '\n', to - pos);
+		pos = nl ? (size_t)(nl - buf) + 1 : to;
+	}
+	size_t nlines = nprefix + nnew + nsuffix;
+	if (nlines > ctx->linescap) {
+		struct lineinfo *lines = realloc(ctx->lines, nlines * sizeof(*lines));
+		if (lines == NULL) {
+			errmsg("%s", "unable to allocate line");
+		}
+		ctx->lines = lines;
+		ctx->linescap = nlines;
+	}
+	if (nsuffix > 0) {
+		memmove(ctx->lines + nprefix + nnew, ctx->lines + oldsuffix,
+				nsuffix * sizeof(struct lineinfo));
+	}
+
+	/* Lex their replacements, whose entries follow every other. */
+	size_t irbase = ir->len;
+	ctx->addr = nprefix > 0 ? ctx->lines[nprefix - 1].end : 0;
+	ctx->lineno = nprefix;
+	ctx->nlines = nprefix;
+	initlexer(&lx, buf + from, to - from);
+	for (size_t pos = 0; pos < to - from; ) {
+		size_t n = nextline(&lx, pos, &m, &masked);
+
+		++ctx->lineno;
+		lexline(ctx, buf, from + pos, n, masked ? &m : NULL);
+
+		pos += n + 1;
+	}
+	ctx->nlines = nlines;
+
+	/* Move the lines that follow. */
+	size_t first = nprefix + nnew, last = first;
+	unsigned short delta = nsuffix > 0 ? ctx->addr - ctx->lines[first].start : 0;
+	size_t lineshift = first - oldsuffix;
+	size_t offshift = len - ctx->srclen;
+	int shifting = delta != 0;
+
+	for (size_t i = first; i < nlines && (shifting || lineshift || offshift); ++i) {
+		struct lineinfo *li = &ctx->lines[i];
+
+		li->offset += offshift;
+		if (li->entry >= 0) {
+			ir->lineno[li->entry] += lineshift;
+		}
+		if (!shifting) {
+			continue;
+		}
+
+		last = i + 1;
+		li->start += delta;
+		if (li->flags & LINE_ORG) {
+			shifting = 0;
+			continue;
+		}
+		li->end += delta;
+		if (li->entry >= 0) {
+			unplace(ctx, li->entry);
+			ir->addr[li->entry] += delta;
+		}
+		if (li->sym < 0) {
+			continue;
+		}
+		if (li->flags & LINE_DOLLAR) {
+			const char *s = buf + li->offset;
+			const char *nl = memchr(s, '\n', len - li->offset);
+
+			ctx->symtabs->syms[li->sym].defined = 0;
+			ctx->addr = li->start;
+			ctx->lineno = i + 1;
+			parse(ctx, s, nl ? (size_t)(nl - s) : len - li->offset, NULL);
+			process(ctx);
+		} else if (!(li->flags & LINE_EQU)) {
+			ctx->symtabs->syms[li->sym].value += delta;
+		}
+		moved(ctx, li->sym);
+	}
+	ctx->pass1 = now() - start;
+
+	start = now();
+	ir->nfixups = 0;
+	for (size_t i = irbase; i < ir->len; ++i) {
+		emit(ctx, i);
+	}
+	for (size_t i = first; i < last; ++i) {
+		if (ctx->lines[i].entry >= 0) {
+			emit(ctx, ctx->lines[i].entry);
+		}
+	}
+	if (ctx->nmoved > 0) {
+		rebind(ctx);
+	}
+	backpatch(ctx);
+	bounds(ctx);
+	ctx->pass2 = now() - start;
+}
+
+/* Hold on to a copy of the source just assembled into out. */
+static void
+keep(struct a80 *ctx, const char *buf, size_t len, struct a80_image *out)
+{
+	finish(ctx, out);
+	if (ctx->overlap || ctx->nbudgets > 0) {
+		return;
+	}
+	if (len > ctx->srccap) {
+		char *src = realloc(ctx->src, len);
+		if (src == NULL) {
+			return;
+		}
+		ctx->src = src;
+		ctx->srccap = len;
+	}
+	if (len > 0) {
+		memcpy(ctx->src, buf, len);
+	}
+	ctx->srclen = len;
+	ctx->resident = 1;
+}
+
+/*
+ * As a80_assemble(), but keep the source resident so that a later call with
+ * a revision of it lexes and emits only what the edit affected. Pass the
+ * same image each time and leave it unmodified in between; it is updated in
+ * place. Object code written more than once to the same address, a source
+ * with a tmax, or an edit that leaves most of the resident lines dead, is
+ * reassembled in full.
+ */
+int
+a80_reassemble(struct a80 *ctx, const char *buf, size_t len, struct a80_image *out)
+{
+	if (ctx->resident && ctx->output == out->bytes
+			&& ctx->ndead <= ctx->ir->len / 2) {
+		ctx->resident = 0;
+		ctx->overlap = 0;
+		ctx->nrecalled = 0;
+		ctx->nforgotten = 0;
+		ctx->nsymbols = 0;
+		ctx->ndispatches = 0;
+		ctx->nemitted = 0;
+		ctx->budgeted = 0;
+		ctx->nbudgets = 0;
+		ctx->errline = 0;
+		ctx->err[0] = '\0';
+		if (setjmp(ctx->env) != 0) {
+			return -1;
+		}
+
+		update(ctx, buf, len);
+		if (!ctx->overlap && ctx->nbudgets == 0) {
+			keep(ctx, buf, len, out);
+			return 0;
+		}
+	}
+
+	if (begin(ctx, out) != 0) {
+		return -1;
+	}
+	if (setjmp(ctx->env) != 0) {
+		return -1;
+	}
+
+	ctx->track = 1;
+	ctx->overlap = 0;
+	ctx->nlines = 0;
+	ctx->ndead = 0;
+	memset(ctx->used, 0, sizeof(ctx->used));
+	assemble(ctx, buf, len);
+	keep(ctx, buf, len, out);
+
+	return 0;
+}
+
+const char *
+a80_error(const struct a80 *ctx)
+{
+	return ctx->err;
+}
+
+size_t
+a80_errline(const struct a80 *ctx)
+{
+	return ctx->errline;
+}
+
+void
+a80_stats(const struct a80 *ctx, struct a80_stats *stats)
+{
+	stats->lines = ctx->lineno;
+	stats->allocations = ctx->arena.nallocs;
+	stats->mallocs = ctx->arena.nblocks;
+	stats->bytes = ctx->arena.nbytes;
+	stats->peak = ctx->arena.nreserved;
+	stats->symbols = ctx->nsymbols;
+	stats->lookups = ctx->symtabs ? ctx->symtabs->nlookups : 0;
+	stats->probes = ctx->symtabs ? ctx->symtabs->nprobes : 0;
+	stats->recalled = ctx->nrecalled;
+	stats->memolookups = ctx->nrecalled + ctx->nforgotten;
+	stats->dispatches = ctx->ndispatches;
+	stats->emitted = ctx->nemitted;
+	stats->peepholes = ctx->npeepholes;
+	stats->savedbytes = ctx->nsavedbytes;
+	stats->savedtstates = ctx->nsavedtstates;
+	stats->pruned = ctx->npruned;
+	stats->prunedbytes = ctx->nprunedbytes;
+	stats->pass1 = ctx->pass1;
+	stats->pass2 = ctx->pass2;
+
+	for (size_t k = 0; k < ctx->nchunks; ++k) {
+		const struct arena *arena = &ctx->chunks[k].ctx->arena;
+		stats->allocations += arena->nallocs;
+		stats->mallocs += arena->nblocks;
+		stats->bytes += arena->nbytes;
+		stats->peak += arena->nreserved;
+	}
+}
+
+/*
+ * Describe the instruction that opcode encodes, by matching it against the
+ * table of mnemonics with the bits of its operand fields masked out.
+ * Return -1 if the 8080 defines no such instruction.
+ */
+int
+a80_decode(unsigned char opcode, struct a80_insn *insn)
+{
+	static const unsigned char widths[] = {
+		[ARG_REG] = 7, [ARG_PAIR] = 3, [ARG_STACK] = 3,
+		[ARG_INDEX] = 1, [ARG_VECTOR] = 7,
+	};
+
+	for (size_t i = 0; i < sizeof(mnemonics) / sizeof(mnemonics[0]); ++i) {
+		const struct mnemonic *m = &mnemonics[i];
+		if (m->name == NULL || m->directive != NULL) {
+			continue;
+		}
+
+		unsigned mask1 = m->arg1 < ARG_IMM8 ? widths[m->arg1] << m->shift : 0;
+		unsigned mask2 = m->arg2 < ARG_IMM8 ? widths[m->arg2] : 0;
+		if ((opcode & ~(mask1 | mask2)) != m->opcode) {
+			continue;
+		}
+
+		insn->name = m->name;
+		insn->size = m->size;
+		insn->arg1 = (opcode & mask1) >> m->shift;
+		insn->arg2 = opcode & mask2;
+		insn->cycles = tstates[opcode];
+		insn->untaken = insn->cycles;
+		if ((opcode & 0xc7) == 0xc0 || (opcode & 0xc7) == 0xc4) {
+			insn->untaken -= 6;
+		}
+
+		/* What would be mov m, m is hlt instead. */
+		if (mask2 != 0 && insn->arg1 == 6 && insn->arg2 == 6) {
+			continue;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+/* Return the number of lines of the source kept by a80_reassemble(). */
+size_t
+a80_nlines(const struct a80 *ctx)
+{
+	return ctx->track ? ctx->nlines : 0;
+}
+
+/* Describe line i of the source kept by a80_reassemble(). */
+void
+a80_line(const struct a80 *ctx, size_t i, struct a80_line *line)
+{
+	const struct lineinfo *li = &ctx->lines[i];
+	const struct ir *ir = ctx->ir;
+
+	line->offset = li->offset;
+	line->label = li->sym >= 0 && !(li->flags & LINE_EQU)
+		? ctx->symtabs->syms[li->sym].label : NULL;
+	line->addr = li->flags & LINE_ORG ? li->end : li->start;
+	line->size = 0;
+	line->opcode = -1;
+	line->operand = -1;
+	if (li->entry < 0) {
+		return;
+	}
+
+	long e = li->entry;
+	line->size = ir->size[e];
+	if (ir->opcode[e] >= 0 && mnemonics[ir->op[e]].directive == NULL) {
+		line->opcode = ir->opcode[e];
+	}
+	if (ir->kind[e] == IR_IMM16) {
+		line->operand = (long)ir->arg[e];
+	} else if (ir->kind[e] == IR_SYM16) {
+		line->operand = ctx->symtabs->syms[ir->arg[e]].value;
+	}
+}
+
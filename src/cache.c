@@ -0,0 +1,126 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cache.h"
+
+/* Change whenever the object code generated for a source may change. */
+#define CACHEVERSION 3
+#define MAGIC "a80c"
+
+/*
+ * An entry holds a header of native-endian words, then the object code
+ * between lo and hi. Entries are private to one machine, so no attempt is
+ * made to make them portable.
+ */
+struct header {
+	char magic[4];
+	uint32_t version;
+	uint32_t lo;
+	uint32_t hi;
+};
+
+/*
+ * Hash the source together with the cache version and whatever options
+ * affect its assembly. Two independent 64-bit hashes form the key, which
+ * makes an accidental collision between sources implausible.
+ */
+void
+cachekey(const char *buf, size_t len, const char *options, char key[CACHEKEYLEN + 1])
+{
+	char prefix[64];
+	int n = snprintf(prefix, sizeof(prefix), "a80 %d %s", CACHEVERSION, options);
+	uint64_t h1 = 14695981039346656037ULL;
+	uint64_t h2 = 0x6a09e667f3bcc908ULL;
+
+	for (int i = 0; i < n; ++i) {
+		h1 = (h1 ^ (unsigned char)prefix[i]) * 1099511628211ULL;
+		h2 = (h2 ^ (unsigned char)prefix[i]) * 0x9e3779b97f4a7c15ULL;
+		h2 ^= h2 >> 29;
+	}
+	for (size_t i = 0; i < len; ++i) {
+		h1 = (h1 ^ (unsigned char)buf[i]) * 1099511628211ULL;
+		h2 = (h2 ^ (unsigned char)buf[i]) * 0x9e3779b97f4a7c15ULL;
+		h2 ^= h2 >> 29;
+	}
+
+	snprintf(key, CACHEKEYLEN + 1, "%016llx%016llx",
+			(unsigned long long)h1, (unsigned long long)h2);
+}
+
+static FILE *
+openentry(const char *dir, const char *key, const char *mode)
+{
+	char path[4096];
+	if ((size_t)snprintf(path, sizeof(path), "%s/%s", dir, key) >= sizeof(path)) {
+		return NULL;
+	}
+	return fopen(path, mode);
+}
+
+/* Fill image from the entry for key. Return 0 on a hit, -1 otherwise. */
+int
+cacheload(const char *dir, const char *key, struct a80_image *image)
+{
+	struct header h;
+	FILE *f = openentry(dir, key, "r");
+
+	if (f == NULL) {
+		return -1;
+	}
+	if (fread(&h, sizeof(h), 1, f) != 1 || memcmp(h.magic, MAGIC, 4) != 0
+			|| h.version != CACHEVERSION || h.lo > h.hi
+			|| h.hi > A80_IMAGESIZE) {
+		fclose(f);
+		return -1;
+	}
+
+	memset(image->bytes, 0, sizeof(image->bytes));
+	if (fread(image->bytes + h.lo, 1, h.hi - h.lo, f) != h.hi - h.lo) {
+		fclose(f);
+		return -1;
+	}
+	image->lo = h.lo;
+	image->hi = h.hi;
+
+	fclose(f);
+	return 0;
+}
+
+/*
+ * Record the image of a successful assembly under key. The
+ * entry is written under a temporary name and renamed into place, so that
+ * concurrent readers and writers only ever see complete entries.
+ */
+int
+cachestore(const char *dir, const char *key, const struct a80_image *image)
+{
+	char tmp[4096];
+	struct header h = { MAGIC, CACHEVERSION, image->lo, image->hi };
+	int fd;
+	FILE *f;
+
+	if ((size_t)snprintf(tmp, sizeof(tmp), "%s/.%s.XXXXXX", dir, key) >= sizeof(tmp)) {
+		return -1;
+	}
+	if ((fd = mkstemp(tmp)) < 0) {
+		return -1;
+	}
+	if ((f = fdopen(fd, "w")) == NULL) {
+		close(fd);
+		unlink(tmp);
+		return -1;
+	}
+
+	fwrite(&h, sizeof(h), 1, f);
+	fwrite(image->bytes + image->lo, 1, image->hi - image->lo, f);
+
+	char path[4096];
+	snprintf(path, sizeof(path), "%s/%s", dir, key);
+	if (ferror(f) | fclose(f) || rename(tmp, path) != 0) {
+		unlink(tmp);
+		return -1;
+	}
+	return 0;
+}
@@ -0,0 +1,15 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <stdlib.h>
+
+#include "a80.h"
+
+#define CACHEKEYLEN 32
+
+void cachekey(const char *buf, size_t len, const char *options,
+		char key[CACHEKEYLEN + 1]);
+int cacheload(const char *dir, const char *key, struct a80_image *image);
+int cachestore(const char *dir, const char *key, const struct a80_image *image);
+
+#endif
@@ -0,0 +1,768 @@
+#include <limits.h>
+#include <string.h>
+
+#include "emu.h"
+
+enum { B, C, D, E, H, L, M, A };
+
+#define BDOS 5	/* where CP/M programs call the system */
+
+/* The code that executes an instruction, shared by each of its opcodes. */
+enum handler {
+	H_UNDEF,
+	H_NOP, H_HLT, H_MOV, H_MVI, H_LXI,
+	H_LDA, H_STA, H_LHLD, H_SHLD, H_LDAX, H_STAX, H_XCHG,
+	H_ADD, H_ADC, H_SUB, H_SBB, H_ANA, H_XRA, H_ORA, H_CMP,
+	H_ADI, H_ACI, H_SUI, H_SBI, H_ANI, H_XRI, H_ORI, H_CPI,
+	H_INR, H_DCR, H_INX, H_DCX, H_DAD, H_DAA,
+	H_RLC, H_RRC, H_RAL, H_RAR, H_CMA, H_STC, H_CMC,
+	H_JMP, H_JCC, H_CALL, H_CCC, H_RET, H_RCC, H_RST, H_PCHL,
+	H_SPHL, H_XTHL, H_PUSH, H_POP, H_IN, H_OUT, H_EI, H_DI,
+	H_MOVRR, H_MOVRM, H_MOVMR, H_MVIR,
+	H_END,		/* falls through from a block cut short to the next */
+	H_RELINK,	/* enters a block through a link, since discarded */
+	H_BDOS,		/* makes a CP/M system call, before the code at 5 runs */
+	NHANDLERS,
+};
+
+static const struct {
+	const char *name;
+	enum handler handler;
+} handlers[] = {
+	{ "nop", H_NOP }, { "hlt", H_HLT }, { "mov", H_MOV }, { "mvi", H_MVI },
+	{ "lxi", H_LXI }, { "lda", H_LDA }, { "sta", H_STA }, { "lhld", H_LHLD },
+	{ "shld", H_SHLD }, { "ldax", H_LDAX }, { "stax", H_STAX }, { "xchg", H_XCHG },
+	{ "add", H_ADD }, { "adc", H_ADC }, { "sub", H_SUB }, { "sbb", H_SBB },
+	{ "ana", H_ANA }, { "xra", H_XRA }, { "ora", H_ORA }, { "cmp", H_CMP },
+	{ "adi", H_ADI }, { "aci", H_ACI }, { "sui", H_SUI }, { "sbi", H_SBI },
+	{ "ani", H_ANI }, { "xri", H_XRI }, { "ori", H_ORI }, { "cpi", H_CPI },
+	{ "inr", H_INR }, { "dcr", H_DCR }, { "inx", H_INX }, { "dcx", H_DCX },
+	{ "dad", H_DAD }, { "daa", H_DAA }, { "rlc", H_RLC }, { "rrc", H_RRC },
+	{ "ral", H_RAL }, { "rar", H_RAR }, { "cma", H_CMA }, { "stc", H_STC },
+	{ "cmc", H_CMC }, { "jmp", H_JMP }, { "call", H_CALL }, { "ret", H_RET },
+	{ "rst", H_RST }, { "pchl", H_PCHL }, { "sphl", H_SPHL }, { "xthl", H_XTHL },
+	{ "push", H_PUSH }, { "pop", H_POP }, { "in", H_IN }, { "out", H_OUT },
+	{ "ei", H_EI }, { "di", H_DI },
+	{ "jnz", H_JCC }, { "jz", H_JCC }, { "jnc", H_JCC }, { "jc", H_JCC },
+	{ "jpo", H_JCC }, { "jpe", H_JCC }, { "jp", H_JCC }, { "jm", H_JCC },
+	{ "cnz", H_CCC }, { "cz", H_CCC }, { "cnc", H_CCC }, { "cc", H_CCC },
+	{ "cpo", H_CCC }, { "cpe", H_CCC }, { "cp", H_CCC }, { "cm", H_CCC },
+	{ "rnz", H_RCC }, { "rz", H_RCC }, { "rnc", H_RCC }, { "rc", H_RCC },
+	{ "rpo", H_RCC }, { "rpe", H_RCC }, { "rp", H_RCC }, { "rm", H_RCC },
+};
+
+/*
+ * Load the object code of image into a fresh 8080, which starts at its
+ * lowest address. A program that leaves the first 8 bytes of memory alone
+ * is taken to be written for CP/M: its warm boot at 0 halts, a ret from
+ * the program returns there, and a call or jump to 5 prints as the BDOS
+ * does.
+ */
+void
+cpuinit(struct cpu *cpu, const struct a80_image *image, FILE *in, FILE *out)
+{
+	memset(cpu, 0, sizeof(*cpu));
+	memcpy(cpu->mem, image->bytes, sizeof(cpu->mem));
+	cpu->pc = image->lo < image->hi ? image->lo : 0;
+	cpu->in = in;
+	cpu->out = out;
+	cpu->nblocks = 1;
+
+	if (image->lo > 7 && image->lo < image->hi) {
+		cpu->bdos = 1;
+		cpu->mem[0] = 0x76;	/* hlt */
+		cpu->mem[BDOS] = 0xc9;	/* ret, once the system call is made */
+		if (image->hi <= A80_IMAGESIZE - 2) {
+			/* The CCP calls the program, so it may return to 0. */
+			cpu->sp = A80_IMAGESIZE - 2;
+			cpu->mem[cpu->sp] = 0;
+			cpu->mem[cpu->sp + 1] = 0;
+		}
+	}
+
+	/* Decode every opcode once, from the same table the assembler uses. */
+	for (int op = 0; op < 256; ++op) {
+		struct a80_insn insn;
+
+		if (a80_decode(op, &insn) != 0) {
+			continue;
+		}
+		for (size_t i = 0; i < sizeof(handlers) / sizeof(handlers[0]); ++i) {
+			if (strcmp(insn.name, handlers[i].name) == 0) {
+				cpu->handler[op] = handlers[i].handler;
+				break;
+			}
+		}
+		cpu->arg1[op] = insn.arg1;
+		cpu->arg2[op] = insn.arg2;
+		cpu->size[op] = insn.size;
+
+		/* Conditional branches encode their condition in bits 3 to 5. */
+		switch (cpu->handler[op]) {
+		case H_JCC: case H_CCC: case H_RCC:
+			cpu->arg1[op] = (op >> 3) & 7;
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+/*
+ * Test condition cc, in the order nz, z, nc, c, po, pe, p, m: each pair
+ * tests a flag for 0 and then for 1.
+ */
+static int
+cond(int cc, int z, int cy, int p, int s)
+{
+	int f;
+
+	switch (cc >> 1) {
+	case 0: f = z; break;
+	case 1: f = cy; break;
+	case 2: f = p; break;
+	default: f = s; break;
+	}
+	return cc & 1 ? f : !f;
+}
+
+/* Print as BDOS functions 2 and 9 do; ignore any other. */
+static void
+bdos(struct cpu *cpu)
+{
+	unsigned short de = cpu->reg[D] << 8 | cpu->reg[E];
+
+	switch (cpu->reg[C]) {
+	case 2:
+		fputc(cpu->reg[E], cpu->out);
+		break;
+	case 9:
+		for (unsigned n = 0; n < A80_IMAGESIZE && cpu->mem[de] != '$'; ++n) {
+			fputc(cpu->mem[de++], cpu->out);
+		}
+		break;
+	}
+}
+
+/* Whether a block ends with the instruction handler h. */
+static int
+ends(enum handler h)
+{
+	switch (h) {
+	case H_UNDEF: case H_HLT: case H_JMP: case H_JCC: case H_CALL:
+	case H_CCC: case H_RET: case H_RCC: case H_RST: case H_PCHL:
+		return 1;
+	default:
+		return 0;
+	}
+}
+
+/* Forget every block, once the cache has no room for another. */
+static void
+flush(struct cpu *cpu)
+{
+	memset(cpu->index, 0, sizeof(cpu->index));
+	memset(cpu->pageblocks, 0, sizeof(cpu->pageblocks));
+	memset(cpu->code, 0, sizeof(cpu->code));
+	cpu->nblocks = 1;
+	cpu->nuops = 0;
+	++cpu->flushes;
+}
+
+/*
+ * Return the handler of h for the operands arg1 and arg2, sparing the
+ * common moves between registers the test for memory at hl.
+ */
+static enum handler
+specialize(enum handler h, int arg1, int arg2)
+{
+	switch (h) {
+	case H_MOV:
+		return arg1 == M ? H_MOVMR : arg2 == M ? H_MOVRM : H_MOVRR;
+	case H_MVI:
+		return arg1 == M ? H_MVI : H_MVIR;
+	default:
+		return h;
+	}
+}
+
+/*
+ * Decode the block that starts at addr, with each micro-op pointing into
+ * handlers, and mark each byte it decodes. Only the last instruction of a
+ * block may run past the end of its page, and then by 2 bytes at most.
+ * Under CP/M, a block that starts at 5 begins with the system call, and
+ * one that would run into 5 ends there instead, so that however the code
+ * at 5 is reached, the call is made.
+ */
+static unsigned
+translate(struct cpu *cpu, unsigned short addr, const void *const *handlers)
+{
+	if (cpu->nblocks == NBLOCKS || cpu->nuops + BLOCKLEN + 2 > NUOPS) {
+		flush(cpu);
+	}
+
+	unsigned id = cpu->nblocks++;
+	struct block *b = &cpu->blocks[id];
+	unsigned page = addr >> 8;
+	unsigned short a = addr;
+
+	*b = (struct block){ cpu->nuops, cpu->pageblocks[page], NULL, NULL, addr };
+	cpu->pageblocks[page] = id;
+	cpu->index[addr] = id;
+	++cpu->translated;
+
+	if (addr == BDOS && cpu->bdos) {
+		cpu->uops[cpu->nuops++] = (struct uop){ handlers[H_BDOS], addr, 0, id, 0, 0 };
+	}
+
+	for (int n = 0; ; ++n) {
+		struct uop *u = &cpu->uops[cpu->nuops++];
+		unsigned char op = cpu->mem[a];
+		enum handler h = cpu->handler[op];
+
+		if (n == BLOCKLEN || (n > 0 && (a >> 8 != page || (a == BDOS && cpu->bdos)))) {
+			h = H_END;
+		} else {
+			h = specialize(h, cpu->arg1[op], cpu->arg2[op]);
+		}
+		*u = (struct uop){
+			handlers[h], a,
+			cpu->mem[(unsigned short)(a + 1)]
+				| cpu->mem[(unsigned short)(a + 2)] << 8,
+			id, cpu->arg1[op], cpu->arg2[op],
+		};
+		if (h == H_END) {
+			break;
+		}
+		for (unsigned short i = a; i != (unsigned short)(a + cpu->size[op]); ++i) {
+			cpu->code[i >> 3] |= 1 << (i & 7);
+		}
+		if (ends(h)) {
+			break;
+		}
+		a += cpu->size[op];
+	}
+	return id;
+}
+
+/* Return the block that starts at addr, decoding it if need be. */
+static unsigned
+findblock(struct cpu *cpu, unsigned short addr, const void *const *handlers)
+{
+	unsigned id = cpu->index[addr];
+	return id != 0 ? id : translate(cpu, addr, handlers);
+}
+
+/*
+ * Discard the blocks that may hold the byte at addr, which was written.
+ * Its mark is left in place, so writing it again costs another pass over
+ * the blocks of its page but is never missed. Links into a block that is
+ * discarded lead to its first micro-op, which becomes relink.
+ */
+static void
+invalidate(struct cpu *cpu, unsigned short addr, const void *relink)
+{
+	unsigned page = addr >> 8;
+
+	for (int i = 0; i < 2; ++i) {
+		for (unsigned id = cpu->pageblocks[page]; id != 0; id = cpu->blocks[id].next) {
+			cpu->uops[cpu->blocks[id].first].handler = relink;
+			cpu->index[cpu->blocks[id].start] = 0;
+			++cpu->invalidated;
+		}
+		cpu->pageblocks[page] = 0;
+
+		/* The last instruction of the page before may reach this byte. */
+		if ((addr & 0xff) >= 2) {
+			break;
+		}
+		page = (page - 1) & 0xff;
+	}
+}
+
+#define MEM(a) mem[(unsigned short)(a)]
+#define IMM8 ((unsigned char)u->imm)
+#define IMM16 (u->imm)
+#define HL (reg[H] << 8 | reg[L])
+
+/* Write memory, discarding any block decoded from the byte written. */
+#define STORE(a, v) \
+	do { \
+		unsigned short a_ = (a); \
+		mem[a_] = (v); \
+		if (cpu->code[a_ >> 3] & (1 << (a_ & 7))) { \
+			invalidate(cpu, a_, labels[H_RELINK]); \
+			stale = 1; \
+		} \
+	} while (0)
+#define GET(r) ((r) == M ? MEM(HL) : reg[r])
+#define SET(r, v) \
+	do { \
+		if ((r) == M) STORE(HL, v); \
+		else reg[r] = (v); \
+	} while (0)
+#define PAIR(i) ((i) == 3 ? sp : (unsigned short)(reg[2 * (i)] << 8 | reg[2 * (i) + 1]))
+#define SETPAIR(i, v) \
+	do { \
+		unsigned short v_ = (v); \
+		if ((i) == 3) sp = v_; \
+		else reg[2 * (i)] = v_ >> 8, reg[2 * (i) + 1] = v_; \
+	} while (0)
+#define PUSH(v) \
+	do { \
+		unsigned short v_ = (v); \
+		sp -= 2; \
+		STORE(sp, v_); \
+		STORE(sp + 1, v_ >> 8); \
+	} while (0)
+#define POP() (sp += 2, (unsigned short)(MEM(sp - 2) | MEM(sp - 1) << 8))
+#define SZP(v) \
+	do { \
+		unsigned char r_ = (v); \
+		s = r_ >> 7; \
+		z = r_ == 0; \
+		p = !__builtin_parity(r_); \
+	} while (0)
+#define ADD(v, carry) \
+	do { \
+		unsigned a_ = reg[A], b_ = (v); \
+		unsigned sum_ = a_ + b_ + (carry); \
+		cy = sum_ >> 8; \
+		ac = ((a_ ^ b_ ^ sum_) >> 4) & 1; \
+		reg[A] = sum_; \
+		SZP(sum_); \
+	} while (0)
+/* The 8080 subtracts by adding the complement; ac is the carry of that. */
+#define SUB(v, borrow, store) \
+	do { \
+		unsigned a_ = reg[A], b_ = (v); \
+		unsigned diff_ = a_ - b_ - (borrow); \
+		cy = (diff_ >> 8) & 1; \
+		ac = (~(a_ ^ b_ ^ diff_) >> 4) & 1; \
+		if (store) reg[A] = diff_; \
+		SZP(diff_); \
+	} while (0)
+#define LOGIC(result, halfcarry) \
+	do { \
+		unsigned char res_ = (result); \
+		ac = (halfcarry); \
+		cy = 0; \
+		reg[A] = res_; \
+		SZP(res_); \
+	} while (0)
+
+/*
+ * Run the micro-op u, jumping straight to its handler. Every handler ends
+ * with a dispatch of its own, so the indirect branch that follows one
+ * instruction is predicted from that instruction alone.
+ */
+#define DISPATCH() goto *u->handler
+#define NEXT() \
+	do { \
+		++u; \
+		DISPATCH(); \
+	} while (0)
+/*
+ * Instructions are counted a block at a time: on leaving a block, those
+ * from its entry up to u, and u itself if it ran.
+ */
+#define RETIRE(ran) (budget -= u - entry + (ran))
+/* Start the block whose first micro-op is u, if the budget allows. */
+#define BEGIN() \
+	do { \
+		entry = u; \
+		if (budget <= 0) goto limit; \
+		DISPATCH(); \
+	} while (0)
+/* As NEXT(), after a write that may have discarded the rest of the block. */
+#define NEXTSTORE(n) \
+	do { \
+		if (stale) { \
+			stale = 0; \
+			RETIRE(1); \
+			GO(u->pc + (n)); \
+		} \
+		NEXT(); \
+	} while (0)
+/* Continue at the block that starts at target. */
+#define GO(target) \
+	do { \
+		u = &cpu->uops[blocks[findblock(cpu, (target), labels)].first]; \
+		BEGIN(); \
+	} while (0)
+/*
+ * Continue at target, which is fixed for the end of this block, through its
+ * link if it has one. A flush while finding the block would have given this
+ * one to another, so then no link is made.
+ */
+#define CHAIN(target, link) \
+	do { \
+		struct block *b_ = &blocks[u->block]; \
+		if (b_->link != NULL) { \
+			from = &b_->link; \
+			u = b_->link; \
+		} else { \
+			unsigned long long flushes_ = cpu->flushes; \
+			u = &cpu->uops[blocks[findblock(cpu, (target), labels)].first]; \
+			if (cpu->flushes == flushes_) b_->link = u; \
+		} \
+		BEGIN(); \
+	} while (0)
+
+/*
+ * Execute instructions from cpu->pc until the cpu halts, or until it ends a
+ * block with at least limit of them run; a limit of 0 runs without one.
+ * Instructions are decoded a block at a time into micro-ops, which are
+ * cached until their code is written.
+ * Dispatch is threaded through a table of label addresses, a GNU
+ * extension, and so -Wpedantic is quiet here.
+ */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+enum cpustop
+cpurun(struct cpu *cpu, unsigned long long limit)
+{
+	static const void *const labels[NHANDLERS] = {
+		[H_UNDEF] = &&undef, [H_NOP] = &&nop, [H_HLT] = &&hlt,
+		[H_MOV] = &&mov, [H_MVI] = &&mvi, [H_LXI] = &&lxi,
+		[H_LDA] = &&lda, [H_STA] = &&sta, [H_LHLD] = &&lhld,
+		[H_SHLD] = &&shld, [H_LDAX] = &&ldax, [H_STAX] = &&stax,
+		[H_XCHG] = &&xchg, [H_ADD] = &&add, [H_ADC] = &&adc,
+		[H_SUB] = &&sub, [H_SBB] = &&sbb, [H_ANA] = &&ana,
+		[H_XRA] = &&xra, [H_ORA] = &&ora, [H_CMP] = &&cmp,
+		[H_ADI] = &&adi, [H_ACI] = &&aci, [H_SUI] = &&sui,
+		[H_SBI] = &&sbi, [H_ANI] = &&ani, [H_XRI] = &&xri,
+		[H_ORI] = &&ori, [H_CPI] = &&cpi, [H_INR] = &&inr,
+		[H_DCR] = &&dcr, [H_INX] = &&inx, [H_DCX] = &&dcx,
+		[H_DAD] = &&dad, [H_DAA] = &&daa, [H_RLC] = &&rlc,
+		[H_RRC] = &&rrc, [H_RAL] = &&ral, [H_RAR] = &&rar,
+		[H_CMA] = &&cma, [H_STC] = &&stc, [H_CMC] = &&cmc,
+		[H_JMP] = &&jmp, [H_JCC] = &&jcc, [H_CALL] = &&call,
+		[H_CCC] = &&ccc, [H_RET] = &&ret, [H_RCC] = &&rcc,
+		[H_RST] = &&rst, [H_PCHL] = &&pchl, [H_SPHL] = &&sphl,
+		[H_XTHL] = &&xthl, [H_PUSH] = &&push, [H_POP] = &&pop,
+		[H_IN] = &&in, [H_OUT] = &&out, [H_EI] = &&ei, [H_DI] = &&di,
+		[H_MOVRR] = &&movrr, [H_MOVRM] = &&movrm, [H_MOVMR] = &&movmr,
+		[H_MVIR] = &&mvir, [H_END] = &&end, [H_RELINK] = &&relink,
+		[H_BDOS] = &&bdos,
+	};
+	struct block *blocks = cpu->blocks;
+	const struct uop **from = NULL;
+	const struct uop *u;
+	unsigned char *mem = cpu->mem;
+	unsigned char *reg = cpu->reg;
+	unsigned short pc;
+	unsigned short sp = cpu->sp;
+	long long start = limit ? (long long)limit : LLONG_MAX;
+	long long budget = start;
+	const struct uop *entry;
+	unsigned char s = cpu->s, z = cpu->z, ac = cpu->ac, p = cpu->p, cy = cpu->cy;
+	enum cpustop stop;
+	int stale = 0;
+
+	GO(cpu->pc);
+
+undef:
+	RETIRE(0);
+	pc = u->pc;
+	stop = CPU_UNDEFINED;
+	goto done;
+limit:
+	pc = u->pc;
+	stop = CPU_LIMIT;
+	goto done;
+hlt:
+	RETIRE(1);
+	pc = u->pc + 1;
+	stop = CPU_HALT;
+	goto done;
+end:
+	/* Not an instruction of its own. */
+	RETIRE(0);
+	CHAIN(u->pc, fall);
+relink: {
+	unsigned long long flushes = cpu->flushes;
+	u = &cpu->uops[blocks[findblock(cpu, u->pc, labels)].first];
+	if (cpu->flushes == flushes) {
+		*from = u;
+	}
+	BEGIN();
+}
+bdos:
+	/* Nor is this; the instructions of the block start after it. */
+	bdos(cpu);
+	++entry;
+	NEXT();
+
+nop:
+	NEXT();
+mov:
+	SET(u->arg1, GET(u->arg2));
+	NEXTSTORE(1);
+mvi:
+	SET(u->arg1, IMM8);
+	NEXTSTORE(2);
+movrr:
+	reg[u->arg1] = reg[u->arg2];
+	NEXT();
+movrm:
+	reg[u->arg1] = MEM(HL);
+	NEXT();
+movmr:
+	STORE(HL, reg[u->arg2]);
+	NEXTSTORE(1);
+mvir:
+	reg[u->arg1] = IMM8;
+	NEXT();
+lxi:
+	SETPAIR(u->arg1, IMM16);
+	NEXT();
+lda:
+	reg[A] = MEM(IMM16);
+	NEXT();
+sta:
+	STORE(IMM16, reg[A]);
+	NEXTSTORE(3);
+lhld:
+	reg[L] = MEM(IMM16);
+	reg[H] = MEM(IMM16 + 1);
+	NEXT();
+shld:
+	STORE(IMM16, reg[L]);
+	STORE(IMM16 + 1, reg[H]);
+	NEXTSTORE(3);
+ldax:
+	reg[A] = MEM(PAIR(u->arg1));
+	NEXT();
+stax:
+	STORE(PAIR(u->arg1), reg[A]);
+	NEXTSTORE(1);
+xchg: {
+	unsigned char t = reg[H];
+	reg[H] = reg[D];
+	reg[D] = t;
+	t = reg[L];
+	reg[L] = reg[E];
+	reg[E] = t;
+	NEXT();
+}
+
+add:
+	ADD(GET(u->arg1), 0);
+	NEXT();
+adc:
+	ADD(GET(u->arg1), cy);
+	NEXT();
+sub:
+	SUB(GET(u->arg1), 0, 1);
+	NEXT();
+sbb:
+	SUB(GET(u->arg1), cy, 1);
+	NEXT();
+ana: {
+	unsigned char v = GET(u->arg1);
+	LOGIC(reg[A] & v, ((reg[A] | v) >> 3) & 1);
+	NEXT();
+}
+xra:
+	LOGIC(reg[A] ^ GET(u->arg1), 0);
+	NEXT();
+ora:
+	LOGIC(reg[A] | GET(u->arg1), 0);
+	NEXT();
+cmp:
+	SUB(GET(u->arg1), 0, 0);
+	NEXT();
+adi:
+	ADD(IMM8, 0);
+	NEXT();
+aci:
+	ADD(IMM8, cy);
+	NEXT();
+sui:
+	SUB(IMM8, 0, 1);
+	NEXT();
+sbi:
+	SUB(IMM8, cy, 1);
+	NEXT();
+ani:
+	LOGIC(reg[A] & IMM8, ((reg[A] | IMM8) >> 3) & 1);
+	NEXT();
+xri:
+	LOGIC(reg[A] ^ IMM8, 0);
+	NEXT();
+ori:
+	LOGIC(reg[A] | IMM8, 0);
+	NEXT();
+cpi:
+	SUB(IMM8, 0, 0);
+	NEXT();
+
+inr: {
+	unsigned char v = GET(u->arg1) + 1;
+	SET(u->arg1, v);
+	ac = (v & 0xf) == 0;
+	SZP(v);
+	NEXTSTORE(1);
+}
+dcr: {
+	unsigned char v = GET(u->arg1) - 1;
+	SET(u->arg1, v);
+	ac = (v & 0xf) != 0xf;
+	SZP(v);
+	NEXTSTORE(1);
+}
+inx:
+	SETPAIR(u->arg1, PAIR(u->arg1) + 1);
+	NEXT();
+dcx:
+	SETPAIR(u->arg1, PAIR(u->arg1) - 1);
+	NEXT();
+dad: {
+	unsigned long sum = (unsigned long)HL + PAIR(u->arg1);
+	cy = sum >> 16;
+	reg[H] = sum >> 8;
+	reg[L] = sum;
+	NEXT();
+}
+daa: {
+	unsigned char lo = reg[A] & 0xf, hi = reg[A] >> 4;
+	unsigned char carry = cy, fix = 0;
+	if (ac || lo > 9) {
+		fix += 0x06;
+	}
+	if (cy || hi > 9 || (hi >= 9 && lo > 9)) {
+		fix += 0x60;
+		carry = 1;
+	}
+	ADD(fix, 0);
+	cy = carry;
+	NEXT();
+}
+
+rlc:
+	cy = reg[A] >> 7;
+	reg[A] = reg[A] << 1 | cy;
+	NEXT();
+rrc:
+	cy = reg[A] & 1;
+	reg[A] = reg[A] >> 1 | cy << 7;
+	NEXT();
+ral: {
+	unsigned char carry = cy;
+	cy = reg[A] >> 7;
+	reg[A] = reg[A] << 1 | carry;
+	NEXT();
+}
+rar: {
+	unsigned char carry = cy;
+	cy = reg[A] & 1;
+	reg[A] = reg[A] >> 1 | carry << 7;
+	NEXT();
+}
+cma:
+	reg[A] = ~reg[A];
+	NEXT();
+stc:
+	cy = 1;
+	NEXT();
+cmc:
+	cy = !cy;
+	NEXT();
+
+jmp:
+	RETIRE(1);
+	CHAIN(IMM16, taken);
+jcc:
+	RETIRE(1);
+	if (cond(u->arg1, z, cy, p, s)) {
+		CHAIN(IMM16, taken);
+	}
+	CHAIN(u->pc + 3, fall);
+ccc:
+	if (!cond(u->arg1, z, cy, p, s)) {
+		RETIRE(1);
+		CHAIN(u->pc + 3, fall);
+	}
+	/* fall through */
+call:
+	RETIRE(1);
+	PUSH(u->pc + 3);
+	CHAIN(IMM16, taken);
+ret:
+	RETIRE(1);
+	GO(POP());
+rcc:
+	RETIRE(1);
+	if (cond(u->arg1, z, cy, p, s)) {
+		GO(POP());
+	}
+	CHAIN(u->pc + 1, fall);
+rst:
+	RETIRE(1);
+	PUSH(u->pc + 1);
+	CHAIN(u->arg1 * 8, taken);
+pchl:
+	RETIRE(1);
+	GO(HL);
+sphl:
+	sp = HL;
+	NEXT();
+xthl: {
+	unsigned char t = reg[L];
+	reg[L] = MEM(sp);
+	STORE(sp, t);
+	t = reg[H];
+	reg[H] = MEM(sp + 1);
+	STORE(sp + 1, t);
+	NEXTSTORE(1);
+}
+push:
+	if (u->arg1 == 3) {
+		PUSH(reg[A] << 8 | s << 7 | z << 6 | ac << 4
+				| p << 2 | 2 | cy);
+	} else {
+		PUSH(PAIR(u->arg1));
+	}
+	NEXTSTORE(1);
+pop: {
+	unsigned short v = POP();
+	if (u->arg1 == 3) {
+		reg[A] = v >> 8;
+		s = (v >> 7) & 1;
+		z = (v >> 6) & 1;
+		ac = (v >> 4) & 1;
+		p = (v >> 2) & 1;
+		cy = v & 1;
+	} else {
+		SETPAIR(u->arg1, v);
+	}
+	NEXT();
+}
+in: {
+	int c = cpu->in ? fgetc(cpu->in) : EOF;
+	reg[A] = c == EOF ? 0xff : c;
+	NEXT();
+}
+out:
+	fputc(reg[A], cpu->out);
+	NEXT();
+ei:
+	cpu->inte = 1;
+	NEXT();
+di:
+	cpu->inte = 0;
+	NEXT();
+
+done:
+	cpu->s = s;
+	cpu->z = z;
+	cpu->ac = ac;
+	cpu->p = p;
+	cpu->cy = cy;
+	cpu->pc = pc;
+	cpu->sp = sp;
+	cpu->steps += start - budget;
+	return stop;
+}
+#pragma GCC diagnostic pop
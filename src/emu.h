@@ -0,0 +1,80 @@
+#ifndef EMU_H
+#define EMU_H
+
+#include <stdio.h>
+
+#include "a80.h"
+
+/* Why cpurun() returned. */
+enum cpustop {
+	CPU_HALT,	/* hlt, or a jump to 0 under CP/M */
+	CPU_UNDEFINED,	/* an opcode the 8080 does not define */
+	CPU_LIMIT,	/* the instructions allowed have run */
+};
+
+#define NBLOCKS 4096	/* blocks cached before the cache is flushed */
+#define NUOPS 65536	/* micro-ops cached likewise */
+#define BLOCKLEN 64	/* instructions in a block at most */
+
+/* An instruction as decoded into a block. */
+struct uop {
+	const void *handler;	/* where the code that executes it starts */
+	unsigned short pc;	/* its address */
+	unsigned short imm;	/* its immediate operand, if any */
+	unsigned short block;	/* the block it belongs to */
+	unsigned char arg1;	/* its operand fields */
+	unsigned char arg2;
+};
+
+/*
+ * A straight run of instructions, ending at the first that may branch, at
+ * BLOCKLEN of them, or at the end of the 256-byte page where it starts.
+ * Blocks are numbered from 1; 0 is none. Once its end has been reached,
+ * a block links directly to the blocks that followed it.
+ */
+struct block {
+	unsigned first;			/* index of its first micro-op */
+	unsigned next;			/* the next block of its page */
+	const struct uop *taken;	/* where its branch went, or NULL */
+	const struct uop *fall;		/* where it fell through to, or NULL */
+	unsigned short start;		/* the address of its first instruction */
+};
+
+/*
+ * An 8080 and its memory. Registers are indexed as opcodes encode them: b,
+ * c, d, e, h and l, then a at 7. Index 6, which names the byte at hl, is
+ * unused. Each flag is 0 or 1.
+ */
+struct cpu {
+	unsigned char reg[8];
+	unsigned char s, z, ac, p, cy;
+	unsigned char inte;
+	unsigned short pc;
+	unsigned short sp;
+	int bdos;			/* whether 5 is where CP/M is called */
+	unsigned long long steps;	/* instructions executed */
+	FILE *in;			/* read by in */
+	FILE *out;			/* written by out and the system calls */
+	unsigned char handler[256];	/* how each opcode is executed */
+	unsigned char arg1[256];	/* operand fields of each opcode */
+	unsigned char arg2[256];
+	unsigned char size[256];
+	unsigned char mem[A80_IMAGESIZE];
+
+	/* The block cache, and where in it each address and page begins. */
+	unsigned long long translated;	/* blocks decoded */
+	unsigned long long invalidated;	/* blocks discarded by writes */
+	unsigned long long flushes;	/* times the cache filled up */
+	unsigned nblocks;
+	unsigned nuops;
+	unsigned pageblocks[256];
+	unsigned char code[A80_IMAGESIZE / 8];	/* bytes decoded into blocks */
+	unsigned short index[A80_IMAGESIZE];
+	struct block blocks[NBLOCKS];
+	struct uop uops[NUOPS];
+};
+
+void cpuinit(struct cpu *cpu, const struct a80_image *image, FILE *in, FILE *out);
+enum cpustop cpurun(struct cpu *cpu, unsigned long long limit);
+
+#endif
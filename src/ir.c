@@ -0,0 +1,91 @@
+#include <string.h>
+
+#include "ir.h"
+
+#define INITCAP 1024
+
+#define GROW(ir, column, oldcap, cap) \
+	do { \
+		void *p = arenagrow((ir)->arena, (ir)->column, \
+				(oldcap) * sizeof(*(ir)->column), \
+				(cap) * sizeof(*(ir)->column)); \
+		if (p == NULL) \
+			return -1; \
+		(ir)->column = p; \
+	} while (0)
+
+struct ir *
+initir(struct arena *arena)
+{
+	struct ir *ir = arenaalloc(arena, sizeof(struct ir));
+	if (ir == NULL) {
+		return NULL;
+	}
+
+	memset(ir, 0, sizeof(struct ir));
+	ir->arena = arena;
+
+	return ir;
+}
+
+/* Reserve a zeroed entry at the end of the table and return its index. */
+long
+irappend(struct ir *ir)
+{
+	if (ir->len == ir->cap) {
+		size_t cap = ir->cap ? ir->cap * 2 : INITCAP;
+		GROW(ir, op, ir->cap, cap);
+		GROW(ir, kind, ir->cap, cap);
+		GROW(ir, opcode, ir->cap, cap);
+		GROW(ir, size, ir->cap, cap);
+		GROW(ir, addr, ir->cap, cap);
+		GROW(ir, arg, ir->cap, cap);
+		GROW(ir, lineno, ir->cap, cap);
+		ir->cap = cap;
+	}
+
+	size_t i = ir->len++;
+	ir->op[i] = 0;
+	ir->kind[i] = IR_NONE;
+	ir->opcode[i] = -1;
+	ir->size[i] = 0;
+	ir->addr[i] = 0;
+	ir->arg[i] = 0;
+	ir->lineno[i] = 0;
+
+	return (long)i;
+}
+
+/* Copy len bytes of s into the data pool and return their offset. */
+long
+irdata(struct ir *ir, const char *s, size_t len)
+{
+	if (ir->ndata + len > ir->datacap) {
+		size_t cap = ir->datacap ? ir->datacap : INITCAP;
+		while (cap < ir->ndata + len) {
+			cap *= 2;
+		}
+		GROW(ir, data, ir->datacap, cap);
+		ir->datacap = cap;
+	}
+
+	size_t offset = ir->ndata;
+	memcpy(ir->data + offset, s, len);
+	ir->ndata += len;
+
+	return (long)offset;
+}
+
+/* Record a reference to patch once every symbol has been defined. */
+long
+irfixup(struct ir *ir, struct fixup fixup)
+{
+	if (ir->nfixups == ir->fixupcap) {
+		size_t cap = ir->fixupcap ? ir->fixupcap * 2 : INITCAP;
+		GROW(ir, fixups, ir->fixupcap, cap);
+		ir->fixupcap = cap;
+	}
+
+	ir->fixups[ir->nfixups] = fixup;
+	return (long)ir->nfixups++;
+}
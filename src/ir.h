@@ -0,0 +1,58 @@
+#ifndef IR_H
+#define IR_H
+
+#include <stdlib.h>
+
+#include "arena.h"
+
+enum irkind {
+	IR_NONE,	/* opcode alone */
+	IR_IMM8,	/* literal byte in arg */
+	IR_IMM16,	/* literal word in arg */
+	IR_SYM8,	/* low byte of the symbol whose id is arg */
+	IR_SYM16,	/* word value of the symbol whose id is arg */
+	IR_DATA,	/* size bytes of the data pool starting at arg */
+	IR_SPACE,	/* size zero bytes */
+};
+
+/* A reference to a symbol that was undefined when its bytes were emitted. */
+struct fixup {
+	size_t offset;		/* position in the object code */
+	size_t lineno;
+	unsigned long sym;
+	unsigned char width;	/* bytes to patch */
+};
+
+/*
+ * The first pass lexes each line into one entry of this table. Entries are
+ * stored as parallel arrays, so the second pass touches only the columns it
+ * needs to emit object code.
+ */
+struct ir {
+	struct arena *arena;
+	size_t len;
+	size_t cap;
+
+	unsigned char *op;	/* mnemonic id */
+	unsigned char *kind;	/* enum irkind */
+	short *opcode;		/* leading byte, or -1 if none */
+	unsigned short *size;
+	unsigned short *addr;
+	unsigned long *arg;
+	size_t *lineno;
+
+	unsigned char *data;
+	size_t ndata;
+	size_t datacap;
+
+	struct fixup *fixups;
+	size_t nfixups;
+	size_t fixupcap;
+};
+
+struct ir *initir(struct arena *arena);
+long irappend(struct ir *ir);
+long irdata(struct ir *ir, const char *s, size_t len);
+long irfixup(struct ir *ir, struct fixup fixup);
+
+#endif
@@ -0,0 +1,209 @@
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "lex.h"
+
+#define PAGESIZE 4096
+
+#if defined(__AVX2__)
+#define CHUNK 32
+typedef __m256i chunk;
+#define load(p) _mm256_loadu_si256((const __m256i *)(p))
+#define splat(c) _mm256_set1_epi8(c)
+#define eq(v, k) ((uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, k)))
+#define sub(v, k) _mm256_sub_epi8(v, k)
+#define min(v, k) _mm256_min_epu8(v, k)
+#elif defined(__SSE2__)
+#define CHUNK 16
+typedef __m128i chunk;
+#define load(p) _mm_loadu_si128((const __m128i *)(p))
+#define splat(c) _mm_set1_epi8(c)
+#define eq(v, k) ((uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, k)))
+#define sub(v, k) _mm_sub_epi8(v, k)
+#define min(v, k) _mm_min_epu8(v, k)
+#endif
+
+#ifdef CHUNK
+
+/*
+ * Return whether reading whole chunks from s may touch a page that holds
+ * none of its n characters. The sanitizers object to any read past the
+ * end of an object, so the padded copy is always used under them.
+ */
+static int
+overreads(const char *s, size_t n)
+{
+#ifdef __SANITIZE_ADDRESS__
+	(void)s;
+	(void)n;
+	return 1;
+#else
+	uintptr_t last = (uintptr_t)s + n - 1;
+	uintptr_t edge = (uintptr_t)s + (n + CHUNK - 1) / CHUNK * CHUNK - 1;
+	return last / PAGESIZE != edge / PAGESIZE;
+#endif
+}
+
+/*
+ * Classify the n characters at s, which may number at most LEXWIDTH, a
+ * chunk of characters per compare. Chunks are loaded straight from the
+ * input when the bytes past its end lie on a page that is already mapped,
+ * and from a zeroed copy otherwise.
+ */
+void
+classify(const char *s, size_t n, struct lexmask *m)
+{
+	char buf[LEXWIDTH + CHUNK];
+	const chunk semi = splat(';'), quote = splat('\''), comma = splat(',');
+	const chunk colon = splat(':'), space = splat(' '), newline = splat('\n');
+	const chunk tab = splat('\t'), four = splat(4);
+
+	if (overreads(s, n)) {
+		memcpy(buf, s, n);
+		memset(buf + n, 0, sizeof(buf) - n);
+		s = buf;
+	}
+
+	memset(m, 0, sizeof(*m));
+	for (size_t i = 0; i < n; i += CHUNK) {
+		chunk v = load(s + i);
+
+		/* Tab through carriage return lie within four of one another. */
+		chunk ctl = sub(v, tab);
+
+		m->semi |= eq(v, semi) << i;
+		m->quote |= eq(v, quote) << i;
+		m->comma |= eq(v, comma) << i;
+		m->colon |= eq(v, colon) << i;
+		m->space |= (eq(v, space) | eq(min(ctl, four), ctl)) << i;
+		m->newline |= eq(v, newline) << i;
+	}
+
+	/* Drop whatever was matched past the end of the line. */
+	if (n < 64) {
+		uint64_t keep = ((uint64_t)1 << n) - 1;
+		m->semi &= keep;
+		m->quote &= keep;
+		m->comma &= keep;
+		m->colon &= keep;
+		m->space &= keep;
+		m->newline &= keep;
+	}
+}
+
+#else
+
+void
+classify(const char *s, size_t n, struct lexmask *m)
+{
+	memset(m, 0, sizeof(*m));
+	for (size_t i = 0; i < n; ++i) {
+		uint64_t bit = (uint64_t)1 << i;
+		switch (s[i]) {
+		case ';':
+			m->semi |= bit;
+			break;
+		case '\'':
+			m->quote |= bit;
+			break;
+		case ',':
+			m->comma |= bit;
+			break;
+		case ':':
+			m->colon |= bit;
+			break;
+		case '\n':
+			m->newline |= bit;
+			/* FALLTHROUGH */
+		case ' ':
+		case '\t':
+		case '\v':
+		case '\f':
+		case '\r':
+			m->space |= bit;
+			break;
+		}
+	}
+}
+
+#endif
+
+static void
+fill(struct lexer *lx, struct lexmask *m, size_t at)
+{
+	if (at >= lx->len) {
+		memset(m, 0, sizeof(*m));
+	} else {
+		size_t n = lx->len - at;
+		classify(lx->buf + at, n < LEXWIDTH ? n : LEXWIDTH, m);
+	}
+}
+
+void
+initlexer(struct lexer *lx, const char *buf, size_t len)
+{
+	lx->buf = buf;
+	lx->len = len;
+	lx->base = 0;
+	fill(lx, &lx->block[0], 0);
+	fill(lx, &lx->block[1], LEXWIDTH);
+}
+
+static uint64_t
+window(uint64_t lo, uint64_t hi, size_t offset)
+{
+	return offset == 0 ? lo : lo >> offset | hi << (LEXWIDTH - offset);
+}
+
+/*
+ * Return the length of the line at pos, not counting its newline. If the
+ * line is shorter than LEXWIDTH, set *masked and store its masks in m.
+ * Lines must be visited in order.
+ */
+size_t
+nextline(struct lexer *lx, size_t pos, struct lexmask *m, int *masked)
+{
+	if (pos >= lx->base + 2 * LEXWIDTH) {
+		/* Skip the blocks of a long line rather than classify them. */
+		lx->base = pos;
+		fill(lx, &lx->block[0], pos);
+		fill(lx, &lx->block[1], pos + LEXWIDTH);
+	} else if (pos >= lx->base + LEXWIDTH) {
+		lx->block[0] = lx->block[1];
+		lx->base += LEXWIDTH;
+		fill(lx, &lx->block[1], lx->base + LEXWIDTH);
+	}
+
+	const struct lexmask *lo = &lx->block[0], *hi = &lx->block[1];
+	size_t offset = pos - lx->base;
+	size_t rest = lx->len - pos;
+	size_t n;
+
+	uint64_t newline = window(lo->newline, hi->newline, offset);
+	if (newline != 0) {
+		n = __builtin_ctzll(newline);
+	} else if (rest < LEXWIDTH) {
+		n = rest;
+	} else {
+		const char *nl = memchr(lx->buf + pos, '\n', rest);
+		*masked = 0;
+		return nl ? (size_t)(nl - (lx->buf + pos)) : rest;
+	}
+
+	uint64_t keep = ((uint64_t)1 << n) - 1;
+	m->semi = window(lo->semi, hi->semi, offset) & keep;
+	m->quote = window(lo->quote, hi->quote, offset) & keep;
+	m->comma = window(lo->comma, hi->comma, offset) & keep;
+	m->colon = window(lo->colon, hi->colon, offset) & keep;
+	m->space = window(lo->space, hi->space, offset) & keep;
+	m->newline = 0;
+	*masked = 1;
+
+	return n;
+}
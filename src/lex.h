@@ -0,0 +1,40 @@
+#ifndef LEX_H
+#define LEX_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Characters covered by one set of masks. */
+#define LEXWIDTH 64
+
+/*
+ * Bit i of each mask is set when character i of the line belongs to the
+ * class, so that the separators of a line can be found with bit arithmetic
+ * rather than repeated scans.
+ */
+struct lexmask {
+	uint64_t semi;
+	uint64_t quote;
+	uint64_t comma;
+	uint64_t colon;
+	uint64_t space;		/* as isspace() in the C locale */
+	uint64_t newline;
+};
+
+/*
+ * Classifies a whole buffer, LEXWIDTH characters at a time, a block ahead
+ * of the line being lexed. Each character is compared once, and lines are
+ * found from the newline mask rather than by a separate scan.
+ */
+struct lexer {
+	const char *buf;
+	size_t len;
+	size_t base;		/* offset of the first block */
+	struct lexmask block[2];
+};
+
+void classify(const char *s, size_t n, struct lexmask *m);
+void initlexer(struct lexer *lx, const char *buf, size_t len);
+size_t nextline(struct lexer *lx, size_t pos, struct lexmask *m, int *masked);
+
+#endif
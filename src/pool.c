@@ -0,0 +1,133 @@
+#include <pthread.h>
+
+#include "pool.h"
+
+/*
+ * Each worker owns a contiguous range of the items. A worker takes items
+ * from the front of its own range and, once that is exhausted, steals the
+ * back half of the range of another worker.
+ */
+struct range {
+	pthread_mutex_t lock;
+	size_t lo;
+	size_t hi;
+};
+
+struct pool {
+	struct range *ranges;
+	size_t nworkers;
+	void (*fn)(void *arg, size_t worker, size_t i);
+	void *arg;
+};
+
+struct worker {
+	struct pool *pool;
+	size_t id;
+};
+
+static int
+take(struct range *r, size_t *i)
+{
+	int ok = 0;
+
+	pthread_mutex_lock(&r->lock);
+	if (r->lo < r->hi) {
+		*i = r->lo++;
+		ok = 1;
+	}
+	pthread_mutex_unlock(&r->lock);
+
+	return ok;
+}
+
+static int
+steal(struct pool *pool, size_t self)
+{
+	for (size_t k = 1; k < pool->nworkers; ++k) {
+		struct range *victim = &pool->ranges[(self + k) % pool->nworkers];
+		size_t lo = 0, hi = 0;
+
+		pthread_mutex_lock(&victim->lock);
+		if (victim->lo < victim->hi) {
+			hi = victim->hi;
+			lo = hi - (hi - victim->lo + 1) / 2;
+			victim->hi = lo;
+		}
+		pthread_mutex_unlock(&victim->lock);
+
+		if (lo < hi) {
+			struct range *own = &pool->ranges[self];
+			pthread_mutex_lock(&own->lock);
+			own->lo = lo;
+			own->hi = hi;
+			pthread_mutex_unlock(&own->lock);
+			return 1;
+		}
+	}
+	return 0;
+}
+
+static void *
+work(void *p)
+{
+	struct worker *w = p;
+	struct pool *pool = w->pool;
+	size_t i;
+
+	do {
+		while (take(&pool->ranges[w->id], &i)) {
+			pool->fn(pool->arg, w->id, i);
+		}
+	} while (steal(pool, w->id));
+
+	return NULL;
+}
+
+/*
+ * Call fn(arg, worker, i) for every i below n across nworkers threads, the
+ * calling thread among them. worker identifies the calling thread so that
+ * fn may keep per-thread state. Should a thread fail to start, the others
+ * steal its share.
+ */
+void
+parallelfor(size_t nworkers, size_t n,
+		void (*fn)(void *arg, size_t worker, size_t i), void *arg)
+{
+	if (nworkers > n) {
+		nworkers = n;
+	}
+	if (nworkers <= 1) {
+		for (size_t i = 0; i < n; ++i) {
+			fn(arg, 0, i);
+		}
+		return;
+	}
+
+	struct range ranges[nworkers];
+	struct worker workers[nworkers];
+	pthread_t threads[nworkers];
+	int started[nworkers];
+	struct pool pool = { ranges, nworkers, fn, arg };
+
+	for (size_t k = 0; k < nworkers; ++k) {
+		pthread_mutex_init(&ranges[k].lock, NULL);
+		ranges[k].lo = n * k / nworkers;
+		ranges[k].hi = n * (k + 1) / nworkers;
+		workers[k].pool = &pool;
+		workers[k].id = k;
+	}
+
+	for (size_t k = 1; k < nworkers; ++k) {
+		started[k] = pthread_create(&threads[k], NULL, work, &workers[k]) == 0;
+	}
+	work(&workers[0]);
+
+	for (size_t k = 1; k < nworkers; ++k) {
+		if (started[k]) {
+			pthread_join(threads[k], NULL);
+		}
+	}
+	for (size_t k = 0; k < nworkers; ++k) {
+		pthread_mutex_destroy(&ranges[k].lock);
+	}
+}
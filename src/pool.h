@@ -0,0 +1,9 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <stdlib.h>
+
+void parallelfor(size_t nworkers, size_t n,
+		void (*fn)(void *arg, size_t worker, size_t i), void *arg);
+
+#endif
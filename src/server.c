@@ -0,0 +1,308 @@
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "server.h"
+
+#define MAGIC 0x73303861	/* "a80s" */
+#define BACKLOG 64
+#define MAXSOURCE (8 << 20)	/* bytes of source a request may carry */
+#define TIMEOUT 10		/* seconds a client may keep a worker waiting */
+
+/*
+ * A client sends a request header and then its source; the server replies
+ * with a response header and then the object code between lo and hi. Both
+ * ends share a machine, so words are sent in native byte order. Each
+ * connection carries a single request, so that no client can hold on to a
+ * worker between requests, and a client that sends more than MAXSOURCE
+ * bytes, or stalls for TIMEOUT seconds, is dropped.
+ */
+struct request {
+	uint32_t magic;
+	uint32_t flags;
+	uint64_t len;
+};
+
+struct response {
+	uint32_t magic;
+	int32_t status;
+	uint64_t errline;
+	uint64_t lo;
+	uint64_t hi;
+	char err[128];
+};
+
+/* Each worker assembles with its own context and image. */
+struct worker {
+	int listenfd;
+	struct a80 *ctx;
+	struct a80_image image;
+	char *buf;
+	size_t cap;
+};
+
+const char *
+serverpath(void)
+{
+	const char *path = getenv("A80_SOCKET");
+	return path && *path ? path : SERVERSOCKET;
+}
+
+/* Read exactly n bytes, failing at end of file as at any error. */
+static int
+readfull(int fd, void *p, size_t n)
+{
+	char *s = p;
+
+	while (n > 0) {
+		ssize_t nread = read(fd, s, n);
+		if (nread < 0 && errno == EINTR) {
+			continue;
+		}
+		if (nread <= 0) {
+			return -1;
+		}
+		s += nread;
+		n -= nread;
+	}
+	return 0;
+}
+
+/* Write n bytes without raising SIGPIPE should the peer have gone. */
+static int
+writefull(int fd, const void *p, size_t n)
+{
+	const char *s = p;
+
+	while (n > 0) {
+		ssize_t nwritten = send(fd, s, n, MSG_NOSIGNAL);
+		if (nwritten < 0 && errno == EINTR) {
+			continue;
+		}
+		if (nwritten < 0) {
+			return -1;
+		}
+		s += nwritten;
+		n -= nwritten;
+	}
+	return 0;
+}
+
+/* Assemble one request from fd and reply to it. */
+static int
+handle(struct worker *w, int fd)
+{
+	struct request req;
+	struct response res = { MAGIC, 0, 0, 0, 0, "" };
+	int ret;
+
+	if (readfull(fd, &req, sizeof(req)) != 0 || req.magic != MAGIC
+			|| req.len > MAXSOURCE) {
+		return -1;
+	}
+	if (req.len > w->cap) {
+		char *buf = realloc(w->buf, req.len);
+		if (buf == NULL) {
+			return -1;
+		}
+		w->buf = buf;
+		w->cap = req.len;
+	}
+	if (readfull(fd, w->buf, req.len) != 0) {
+		return -1;
+	}
+
+	/* fmemopen() refuses an empty buffer, which either mode assembles alike. */
+	if ((req.flags & REQ_ONEPASS) && req.len > 0) {
+		FILE *stream = fmemopen(w->buf, req.len, "r");
+		if (stream == NULL) {
+			return -1;
+		}
+		ret = a80_assemblestream(w->ctx, stream, &w->image);
+		fclose(stream);
+	} else {
+		ret = a80_assemble(w->ctx, w->buf, req.len, &w->image);
+	}
+
+	if (ret != 0) {
+		res.status = -1;
+		res.errline = a80_errline(w->ctx);
+		snprintf(res.err, sizeof(res.err), "%s", a80_error(w->ctx));
+	} else {
+		res.lo = w->image.lo;
+		res.hi = w->image.hi;
+	}
+	if (writefull(fd, &res, sizeof(res)) != 0) {
+		return -1;
+	}
+	return writefull(fd, w->image.bytes + res.lo, res.hi - res.lo);
+}
+
+static void *
+work(void *p)
+{
+	struct worker *w = p;
+	struct timeval timeout = { TIMEOUT, 0 };
+
+	for (;;) {
+		int fd = accept(w->listenfd, NULL, NULL);
+		if (fd < 0) {
+			if (errno == EINTR || errno == ECONNABORTED) {
+				continue;
+			}
+			return NULL;
+		}
+		if (setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) != 0
+				|| setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout)) != 0) {
+			close(fd);
+			continue;
+		}
+		handle(w, fd);
+		close(fd);
+	}
+}
+
+/*
+ * Listen on the Unix domain socket at path, replacing a socket left there
+ * by a server that has gone but no other file, nor the socket of a server
+ * still listening, and serve requests from nworkers threads. Each thread
+ * accepts connections of its own, so as many clients are served at once.
+ * Returns only if the socket cannot be set up or accept() fails.
+ */
+int
+serve(const char *path, size_t nworkers)
+{
+	struct sockaddr_un addr = { .sun_family = AF_UNIX };
+	int fd;
+
+	if (strlen(path) >= sizeof(addr.sun_path)) {
+		errno = ENAMETOOLONG;
+		return -1;
+	}
+	strcpy(addr.sun_path, path);
+
+	/* Take over the socket of a server that has gone, and nothing else. */
+	struct stat st;
+	if (lstat(path, &st) == 0) {
+		if (!S_ISSOCK(st.st_mode)) {
+			errno = EEXIST;
+			return -1;
+		}
+		if ((fd = connectserver(path)) >= 0) {
+			close(fd);
+			errno = EADDRINUSE;
+			return -1;
+		}
+		unlink(path);
+	}
+
+	if ((fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)) < 0) {
+		return -1;
+	}
+	if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, BACKLOG) != 0) {
+		close(fd);
+		return -1;
+	}
+
+	struct worker *workers = calloc(nworkers, sizeof(struct worker));
+	if (workers == NULL) {
+		close(fd);
+		return -1;
+	}
+	for (size_t i = 0; i < nworkers; ++i) {
+		workers[i].listenfd = fd;
+		if ((workers[i].ctx = a80_new()) == NULL) {
+			close(fd);
+			return -1;
+		}
+	}
+
+	/* The calling thread serves as the first worker. */
+	for (size_t i = 1; i < nworkers; ++i) {
+		pthread_t thread;
+		if (pthread_create(&thread, NULL, work, &workers[i]) == 0) {
+			pthread_detach(thread);
+		}
+	}
+	work(&workers[0]);
+
+	close(fd);
+	return -1;
+}
+
+int
+connectserver(const char *path)
+{
+	struct sockaddr_un addr = { .sun_family = AF_UNIX };
+	int fd;
+
+	if (strlen(path) >= sizeof(addr.sun_path)) {
+		errno = ENAMETOOLONG;
+		return -1;
+	}
+	strcpy(addr.sun_path, path);
+
+	if ((fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)) < 0) {
+		return -1;
+	}
+	if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+		int saved = errno;
+		close(fd);
+		errno = saved;
+		return -1;
+	}
+	return fd;
+}
+
+/*
+ * Assemble the len bytes of source at buf on the server newly connected to
+ * fd.
+ * Return 0 with the object code in image, or -1 with a diagnosis in err
+ * and its line in errline, which is zero if the server could not be
+ * reached.
+ */
+int
+remoteassemble(int fd, const char *buf, size_t len, int flags,
+		struct a80_image *image, size_t *errline, char *err, size_t errsize)
+{
+	struct request req = { MAGIC, (uint32_t)flags, len };
+	struct response res;
+
+	if (len > MAXSOURCE) {
+		*errline = 0;
+		snprintf(err, errsize, "server: %s", "source too large");
+		return -1;
+	}
+	errno = 0;
+	if (writefull(fd, &req, sizeof(req)) != 0 || writefull(fd, buf, len) != 0
+			|| readfull(fd, &res, sizeof(res)) != 0 || res.magic != MAGIC
+			|| res.lo > res.hi || res.hi > A80_IMAGESIZE) {
+		*errline = 0;
+		snprintf(err, errsize, "server: %s", errno ? strerror(errno) : "bad response");
+		return -1;
+	}
+	if (res.status != 0) {
+		*errline = res.errline;
+		snprintf(err, errsize, "%s", res.err);
+		return -1;
+	}
+
+	memset(image->bytes, 0, res.lo);
+	memset(image->bytes + res.hi, 0, A80_IMAGESIZE - res.hi);
+	image->lo = res.lo;
+	image->hi = res.hi;
+	if (readfull(fd, image->bytes + res.lo, res.hi - res.lo) != 0) {
+		*errline = 0;
+		snprintf(err, errsize, "server: %s", "connection lost");
+		return -1;
+	}
+	return 0;
+}
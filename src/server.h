@@ -0,0 +1,20 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <stdlib.h>
+
+#include "a80.h"
+
+/* Where the server listens unless A80_SOCKET names another socket. */
+#define SERVERSOCKET "/tmp/a80.sock"
+
+/* Flags of a request. */
+#define REQ_ONEPASS 1
+
+const char *serverpath(void);
+int serve(const char *path, size_t nworkers);
+int connectserver(const char *path);
+int remoteassemble(int fd, const char *buf, size_t len, int flags,
+		struct a80_image *image, size_t *errline, char *err, size_t errsize);
+
+#endif
@@ -0,0 +1,108 @@
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "source.h"
+
+#define READSIZE 65536
+
+/* Read everything from fd into a buffer, for inputs that cannot be mapped. */
+static int
+readall(int fd, struct source *src)
+{
+	size_t cap = 0;
+	ssize_t nread;
+
+	src->buf = NULL;
+	src->len = 0;
+	src->mapped = 0;
+
+	do {
+		if (src->len + READSIZE > cap) {
+			cap = cap ? cap * 2 : READSIZE;
+			char *buf = realloc(src->buf, cap);
+			if (buf == NULL) {
+				free(src->buf);
+				return -1;
+			}
+			src->buf = buf;
+		}
+
+		nread = read(fd, src->buf + src->len, cap - src->len);
+		if (nread < 0 && errno != EINTR) {
+			free(src->buf);
+			return -1;
+		}
+		if (nread > 0) {
+			src->len += nread;
+		}
+	} while (nread != 0);
+
+	return 0;
+}
+
+/*
+ * Make the contents of the file at path available in memory, mapping it
+ * when possible and falling back to reading it for pipes and the like.
+ */
+int
+opensource(const char *path, struct source *src)
+{
+	struct stat st;
+	int fd, ret = 0;
+
+	if ((fd = open(path, O_RDONLY)) < 0) {
+		return -1;
+	}
+
+	if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+		void *p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (p != MAP_FAILED) {
+			src->buf = p;
+			src->len = st.st_size;
+			src->mapped = 1;
+			close(fd);
+			return 0;
+		}
+	}
+
+	ret = readall(fd, src);
+	close(fd);
+
+	return ret;
+}
+
+void
+closesource(struct source *src)
+{
+	if (src->mapped) {
+		munmap(src->buf, src->len);
+	} else {
+		free(src->buf);
+	}
+}
+
+/*
+ * Name the object file after the source at path, dropping its extension,
+ * or adding .bin if it has none. The caller frees the name.
+ */
+char *
+outpath(const char *path)
+{
+	const char *base = strrchr(path, '/');
+	const char *ext = strrchr(base ? base : path, '.');
+	size_t len = ext ? (size_t)(ext - path) : strlen(path);
+
+	char *out = malloc(len + sizeof(".bin"));
+	if (out == NULL) {
+		return NULL;
+	}
+	memcpy(out, path, len);
+	strcpy(out + len, ext ? "" : ".bin");
+
+	return out;
+}
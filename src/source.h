@@ -0,0 +1,16 @@
+#ifndef SOURCE_H
+#define SOURCE_H
+
+#include <stdlib.h>
+
+struct source {
+	char *buf;
+	size_t len;
+	int mapped;
+};
+
+int opensource(const char *path, struct source *src);
+void closesource(struct source *src);
+char *outpath(const char *path);
+
+#endif
@@ -0,0 +1,134 @@
+#include <string.h>
+
+#include "symtab.h"
+
+#define INITSLOTS 256
+
+static unsigned long
+hashstr(const char *s, size_t len)
+{
+	/* FNV-1a */
+	unsigned long h = 2166136261UL;
+	for (size_t i = 0; i < len; ++i) {
+		h ^= (unsigned char)s[i];
+		h *= 16777619UL;
+	}
+	return h;
+}
+
+static size_t *
+probe(struct symtab *symtab, const char *label, size_t len, unsigned long hash)
+{
+	size_t mask = symtab->nslots - 1;
+	size_t i = hash & mask;
+
+	++symtab->nlookups;
+	while (symtab->slots[i] != 0) {
+		++symtab->nprobes;
+		struct symbol *sym = &symtab->syms[symtab->slots[i] - 1];
+		if (sym->hash == hash && strncmp(sym->label, label, len) == 0
+				&& sym->label[len] == '\0') {
+			break;
+		}
+		i = (i + 1) & mask;
+	}
+	return &symtab->slots[i];
+}
+
+static int
+grow(struct symtab *symtab)
+{
+	size_t nslots = symtab->nslots * 2;
+	size_t *slots = arenaalloc(symtab->arena, nslots * sizeof(size_t));
+	if (slots == NULL) {
+		return -1;
+	}
+	memset(slots, 0, nslots * sizeof(size_t));
+
+	for (size_t i = 0; i < symtab->nsyms; ++i) {
+		size_t j = symtab->syms[i].hash & (nslots - 1);
+		while (slots[j] != 0) {
+			j = (j + 1) & (nslots - 1);
+		}
+		slots[j] = i + 1;
+	}
+
+	symtab->slots = slots;
+	symtab->nslots = nslots;
+
+	return 0;
+}
+
+struct symtab *
+initsymtab(struct arena *arena)
+{
+	struct symtab *symtab = arenaalloc(arena, sizeof(struct symtab));
+	if (symtab == NULL) {
+		return NULL;
+	}
+
+	symtab->arena = arena;
+	symtab->nsyms = 0;
+	symtab->cap = INITSLOTS / 2;
+	symtab->nslots = INITSLOTS;
+	symtab->nlookups = 0;
+	symtab->nprobes = 0;
+	symtab->syms = arenaalloc(arena, symtab->cap * sizeof(struct symbol));
+	symtab->slots = arenaalloc(arena, symtab->nslots * sizeof(size_t));
+	if (symtab->syms == NULL || symtab->slots == NULL) {
+		return NULL;
+	}
+	memset(symtab->slots, 0, symtab->nslots * sizeof(size_t));
+
+	return symtab;
+}
+
+/*
+ * Return the index of the symbol named by the len characters of label,
+ * creating an undefined symbol holding its own copy of the string if none
+ * exists yet.
+ */
+long
+intern(struct symtab *symtab, const char *label, size_t len)
+{
+	unsigned long hash = hashstr(label, len);
+	size_t *slot = probe(symtab, label, len, hash);
+
+	if (*slot != 0) {
+		return (long)(*slot - 1);
+	}
+
+	if (symtab->nsyms == symtab->cap) {
+		size_t cap = symtab->cap * 2;
+		struct symbol *syms = arenagrow(symtab->arena, symtab->syms,
+				symtab->cap * sizeof(struct symbol),
+				cap * sizeof(struct symbol));
+		if (syms == NULL) {
+			return -1;
+		}
+		symtab->syms = syms;
+		symtab->cap = cap;
+	}
+
+	/* Keep the load factor at or below one half. */
+	if ((symtab->nsyms + 1) * 2 > symtab->nslots) {
+		if (grow(symtab) != 0) {
+			return -1;
+		}
+		slot = probe(symtab, label, len, hash);
+	}
+
+	struct symbol *sym = &symtab->syms[symtab->nsyms];
+	if ((sym->label = arenaalloc(symtab->arena, len + 1)) == NULL) {
+		return -1;
+	}
+	memcpy(sym->label, label, len);
+	sym->label[len] = '\0';
+	sym->hash = hash;
+	sym->value = 0;
+	sym->defined = 0;
+
+	*slot = ++symtab->nsyms;
+
+	return (long)(symtab->nsyms - 1);
+}
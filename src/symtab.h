@@ -0,0 +1,34 @@
+#ifndef SYMTAB_H
+#define SYMTAB_H
+
+#include <stdlib.h>
+
+#include "arena.h"
+
+struct symbol {
+	char *label;
+	unsigned long hash;
+	unsigned short value;
+	int defined;
+};
+
+/*
+ * Symbols live in a dense array so that their indices remain stable as the
+ * table grows. The open-addressed slots refer to symbols by index plus one,
+ * leaving zero to mark an empty slot.
+ */
+struct symtab {
+	struct arena *arena;
+	struct symbol *syms;
+	size_t nsyms;
+	size_t cap;
+	size_t *slots;
+	size_t nslots;
+	size_t nlookups;	/* searches of the slots by intern() */
+	size_t nprobes;		/* occupied slots examined by them */
+};
+
+struct symtab *initsymtab(struct arena *arena);
+long intern(struct symtab *symtab, const char *label, size_t len);
+
+#endif
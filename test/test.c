@@ -0,0 +1,1187 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "a80.h"
+#include "emu.h"
+
+/*
+ * Assemble sources held in this file and compare what comes of them with
+ * object code worked out by hand, or with what another way of assembling
+ * the same source produces. Each suite is a function; name suites on the
+ * command line to run only those.
+ */
+
+static const char *suite;
+static int nchecks;
+static int nfailed;
+
+static struct a80_image image;
+static struct a80_image other;
+
+static unsigned long long rng;
+
+static unsigned long
+rand32(void)
+{
+	/* xorshift64* */
+	rng ^= rng >> 12;
+	rng ^= rng << 25;
+	rng ^= rng >> 27;
+	return (unsigned long)((rng * 0x2545f4914f6cdd1dULL) >> 32);
+}
+
+/* Count a check, reporting it if ok is false. */
+static int
+check(int ok, const char *fmt, ...)
+{
+	va_list ap;
+
+	++nchecks;
+	if (ok) {
+		return 1;
+	}
+	++nfailed;
+	fprintf(stderr, "FAIL %s: ", suite);
+	va_start(ap, fmt);
+	vfprintf(stderr, fmt, ap);
+	va_end(ap);
+	fputc('\n', stderr);
+	return 0;
+}
+
+static struct a80 *
+newctx(void)
+{
+	struct a80 *ctx = a80_new();
+	if (ctx == NULL) {
+		perror("a80test");
+		exit(EXIT_FAILURE);
+	}
+	return ctx;
+}
+
+static int
+assemble(struct a80 *ctx, const char *src, struct a80_image *out)
+{
+	return a80_assemble(ctx, src, strlen(src), out);
+}
+
+/* As assemble(), but in a single pass over src read as a stream. */
+static int
+assemblestream(struct a80 *ctx, const char *src, struct a80_image *out)
+{
+	FILE *f = fmemopen((void *)src, strlen(src), "r");
+	if (f == NULL) {
+		perror("fmemopen");
+		exit(EXIT_FAILURE);
+	}
+	int ret = a80_assemblestream(ctx, f, out);
+	fclose(f);
+	return ret;
+}
+
+/* Spell the object code of img in hex, truncated to fit a static buffer. */
+static const char *
+hex(const struct a80_image *img)
+{
+	static char buf[512];
+	size_t n = 0;
+
+	for (size_t a = img->lo; a < img->hi && n + 3 < sizeof(buf); ++a) {
+		n += snprintf(buf + n, sizeof(buf) - n, "%02x", img->bytes[a]);
+	}
+	buf[n] = '\0';
+	return buf;
+}
+
+/* Return whether a and b hold the same object code over the same range. */
+static int
+sameimage(const struct a80_image *a, const struct a80_image *b)
+{
+	return a->lo == b->lo && a->hi == b->hi
+		&& memcmp(a->bytes, b->bytes, sizeof(a->bytes)) == 0;
+}
+
+/*
+ * Check that two ways of assembling the same source, whose results are in
+ * image and other, agree on its object code or on its diagnosis.
+ */
+static void
+expectsame(const char *what, unsigned long long seed, int ret1, struct a80 *ctx1,
+		int ret2, struct a80 *ctx2)
+{
+	if (ret1 != 0 || ret2 != 0) {
+		check(ret1 == ret2 && a80_errline(ctx1) == a80_errline(ctx2)
+				&& strcmp(a80_error(ctx1), a80_error(ctx2)) == 0,
+				"%s, seed %llu: %zu: %s against %zu: %s", what, seed,
+				a80_errline(ctx1), a80_error(ctx1),
+				a80_errline(ctx2), a80_error(ctx2));
+		return;
+	}
+	check(sameimage(&image, &other), "%s, seed %llu: object code differs",
+			what, seed);
+}
+
+/* Check that src assembles to the object code spelled in want. */
+static void
+expectcode(struct a80 *ctx, const char *src, const char *want)
+{
+	if (!check(assemble(ctx, src, &image) == 0, "%s: %zu: %s", src,
+				a80_errline(ctx), a80_error(ctx))) {
+		return;
+	}
+	check(strcmp(hex(&image), want) == 0, "%s: got %s, want %s",
+			src, hex(&image), want);
+}
+
+/* Check that src fails at line with a diagnosis containing want. */
+static void
+expecterror(struct a80 *ctx, const char *src, size_t line, const char *want)
+{
+	if (!check(assemble(ctx, src, &image) != 0, "%s: assembled", src)) {
+		return;
+	}
+	check(a80_errline(ctx) == line && strstr(a80_error(ctx), want) != NULL,
+			"%s: got %zu: %s, want %zu: %s", src, a80_errline(ctx),
+			a80_error(ctx), line, want);
+}
+
+/* Every instruction the 8080 defines, with its object code. */
+static const struct {
+	const char *line;
+	const char *code;
+} encodings[] = {
+	{ "nop", "00" },
+	{ "lxi b, 1234h", "013412" },
+	{ "stax b", "02" },
+	{ "inx b", "03" },
+	{ "inr b", "04" },
+	{ "dcr b", "05" },
+	{ "mvi b, 56h", "0656" },
+	{ "rlc", "07" },
+	{ "dad b", "09" },
+	{ "ldax b", "0a" },
+	{ "dcx b", "0b" },
+	{ "inr c", "0c" },
+	{ "dcr c", "0d" },
+	{ "mvi c, 56h", "0e56" },
+	{ "rrc", "0f" },
+	{ "lxi d, 1234h", "113412" },
+	{ "stax d", "12" },
+	{ "inx d", "13" },
+	{ "inr d", "14" },
+	{ "dcr d", "15" },
+	{ "mvi d, 56h", "1656" },
+	{ "ral", "17" },
+	{ "dad d", "19" },
+	{ "ldax d", "1a" },
+	{ "dcx d", "1b" },
+	{ "inr e", "1c" },
+	{ "dcr e", "1d" },
+	{ "mvi e, 56h", "1e56" },
+	{ "rar", "1f" },
+	{ "lxi h, 1234h", "213412" },
+	{ "shld 1234h", "223412" },
+	{ "inx h", "23" },
+	{ "inr h", "24" },
+	{ "dcr h", "25" },
+	{ "mvi h, 56h", "2656" },
+	{ "daa", "27" },
+	{ "dad h", "29" },
+	{ "lhld 1234h", "2a3412" },
+	{ "dcx h", "2b" },
+	{ "inr l", "2c" },
+	{ "dcr l", "2d" },
+	{ "mvi l, 56h", "2e56" },
+	{ "cma", "2f" },
+	{ "lxi sp, 1234h", "313412" },
+	{ "sta 1234h", "323412" },
+	{ "inx sp", "33" },
+	{ "inr m", "34" },
+	{ "dcr m", "35" },
+	{ "mvi m, 56h", "3656" },
+	{ "stc", "37" },
+	{ "dad sp", "39" },
+	{ "lda 1234h", "3a3412" },
+	{ "dcx sp", "3b" },
+	{ "inr a", "3c" },
+	{ "dcr a", "3d" },
+	{ "mvi a, 56h", "3e56" },
+	{ "cmc", "3f" },
+	{ "mov b, b", "40" },
+	{ "mov b, c", "41" },
+	{ "mov b, d", "42" },
+	{ "mov b, e", "43" },
+	{ "mov b, h", "44" },
+	{ "mov b, l", "45" },
+	{ "mov b, m", "46" },
+	{ "mov b, a", "47" },
+	{ "mov c, b", "48" },
+	{ "mov c, c", "49" },
+	{ "mov c, d", "4a" },
+	{ "mov c, e", "4b" },
+	{ "mov c, h", "4c" },
+	{ "mov c, l", "4d" },
+	{ "mov c, m", "4e" },
+	{ "mov c, a", "4f" },
+	{ "mov d, b", "50" },
+	{ "mov d, c", "51" },
+	{ "mov d, d", "52" },
+	{ "mov d, e", "53" },
+	{ "mov d, h", "54" },
+	{ "mov d, l", "55" },
+	{ "mov d, m", "56" },
+	{ "mov d, a", "57" },
+	{ "mov e, b", "58" },
+	{ "mov e, c", "59" },
+	{ "mov e, d", "5a" },
+	{ "mov e, e", "5b" },
+	{ "mov e, h", "5c" },
+	{ "mov e, l", "5d" },
+	{ "mov e, m", "5e" },
+	{ "mov e, a", "5f" },
+	{ "mov h, b", "60" },
+	{ "mov h, c", "61" },
+	{ "mov h, d", "62" },
+	{ "mov h, e", "63" },
+	{ "mov h, h", "64" },
+	{ "mov h, l", "65" },
+	{ "mov h, m", "66" },
+	{ "mov h, a", "67" },
+	{ "mov l, b", "68" },
+	{ "mov l, c", "69" },
+	{ "mov l, d", "6a" },
+	{ "mov l, e", "6b" },
+	{ "mov l, h", "6c" },
+	{ "mov l, l", "6d" },
+	{ "mov l, m", "6e" },
+	{ "mov l, a", "6f" },
+	{ "mov m, b", "70" },
+	{ "mov m, c", "71" },
+	{ "mov m, d", "72" },
+	{ "mov m, e", "73" },
+	{ "mov m, h", "74" },
+	{ "mov m, l", "75" },
+	{ "hlt", "76" },
+	{ "mov m, a", "77" },
+	{ "mov a, b", "78" },
+	{ "mov a, c", "79" },
+	{ "mov a, d", "7a" },
+	{ "mov a, e", "7b" },
+	{ "mov a, h", "7c" },
+	{ "mov a, l", "7d" },
+	{ "mov a, m", "7e" },
+	{ "mov a, a", "7f" },
+	{ "add b", "80" },
+	{ "add c", "81" },
+	{ "add d", "82" },
+	{ "add e", "83" },
+	{ "add h", "84" },
+	{ "add l", "85" },
+	{ "add m", "86" },
+	{ "add a", "87" },
+	{ "adc b", "88" },
+	{ "adc c", "89" },
+	{ "adc d", "8a" },
+	{ "adc e", "8b" },
+	{ "adc h", "8c" },
+	{ "adc l", "8d" },
+	{ "adc m", "8e" },
+	{ "adc a", "8f" },
+	{ "sub b", "90" },
+	{ "sub c", "91" },
+	{ "sub d", "92" },
+	{ "sub e", "93" },
+	{ "sub h", "94" },
+	{ "sub l", "95" },
+	{ "sub m", "96" },
+	{ "sub a", "97" },
+	{ "sbb b", "98" },
+	{ "sbb c", "99" },
+	{ "sbb d", "9a" },
+	{ "sbb e", "9b" },
+	{ "sbb h", "9c" },
+	{ "sbb l", "9d" },
+	{ "sbb m", "9e" },
+	{ "sbb a", "9f" },
+	{ "ana b", "a0" },
+	{ "ana c", "a1" },
+	{ "ana d", "a2" },
+	{ "ana e", "a3" },
+	{ "ana h", "a4" },
+	{ "ana l", "a5" },
+	{ "ana m", "a6" },
+	{ "ana a", "a7" },
+	{ "xra b", "a8" },
+	{ "xra c", "a9" },
+	{ "xra d", "aa" },
+	{ "xra e", "ab" },
+	{ "xra h", "ac" },
+	{ "xra l", "ad" },
+	{ "xra m", "ae" },
+	{ "xra a", "af" },
+	{ "ora b", "b0" },
+	{ "ora c", "b1" },
+	{ "ora d", "b2" },
+	{ "ora e", "b3" },
+	{ "ora h", "b4" },
+	{ "ora l", "b5" },
+	{ "ora m", "b6" },
+	{ "ora a", "b7" },
+	{ "cmp b", "b8" },
+	{ "cmp c", "b9" },
+	{ "cmp d", "ba" },
+	{ "cmp e", "bb" },
+	{ "cmp h", "bc" },
+	{ "cmp l", "bd" },
+	{ "cmp m", "be" },
+	{ "cmp a", "bf" },
+	{ "rnz", "c0" },
+	{ "pop b", "c1" },
+	{ "jnz 1234h", "c23412" },
+	{ "jmp 1234h", "c33412" },
+	{ "cnz 1234h", "c43412" },
+	{ "push b", "c5" },
+	{ "adi 56h", "c656" },
+	{ "rst 0", "c7" },
+	{ "rz", "c8" },
+	{ "ret", "c9" },
+	{ "jz 1234h", "ca3412" },
+	{ "cz 1234h", "cc3412" },
+	{ "call 1234h", "cd3412" },
+	{ "aci 56h", "ce56" },
+	{ "rst 1", "cf" },
+	{ "rnc", "d0" },
+	{ "pop d", "d1" },
+	{ "jnc 1234h", "d23412" },
+	{ "out 56h", "d356" },
+	{ "cnc 1234h", "d43412" },
+	{ "push d", "d5" },
+	{ "sui 56h", "d656" },
+	{ "rst 2", "d7" },
+	{ "rc", "d8" },
+	{ "jc 1234h", "da3412" },
+	{ "in 56h", "db56" },
+	{ "cc 1234h", "dc3412" },
+	{ "sbi 56h", "de56" },
+	{ "rst 3", "df" },
+	{ "rpo", "e0" },
+	{ "pop h", "e1" },
+	{ "jpo 1234h", "e23412" },
+	{ "xthl", "e3" },
+	{ "cpo 1234h", "e43412" },
+	{ "push h", "e5" },
+	{ "ani 56h", "e656" },
+	{ "rst 4", "e7" },
+	{ "rpe", "e8" },
+	{ "pchl", "e9" },
+	{ "jpe 1234h", "ea3412" },
+	{ "xchg", "eb" },
+	{ "cpe 1234h", "ec3412" },
+	{ "xri 56h", "ee56" },
+	{ "rst 5", "ef" },
+	{ "rp", "f0" },
+	{ "pop psw", "f1" },
+	{ "jp 1234h", "f23412" },
+	{ "di", "f3" },
+	{ "cp 1234h", "f43412" },
+	{ "push psw", "f5" },
+	{ "ori 56h", "f656" },
+	{ "rst 6", "f7" },
+	{ "rm", "f8" },
+	{ "sphl", "f9" },
+	{ "jm 1234h", "fa3412" },
+	{ "ei", "fb" },
+	{ "cm 1234h", "fc3412" },
+	{ "cpi 56h", "fe56" },
+	{ "rst 7", "ff" },
+};
+
+static void
+testencodings(void)
+{
+	struct a80 *ctx = newctx();
+	char src[64];
+
+	for (size_t i = 0; i < sizeof(encodings) / sizeof(encodings[0]); ++i) {
+		snprintf(src, sizeof(src), "\t%s\n", encodings[i].line);
+		expectcode(ctx, src, encodings[i].code);
+	}
+
+	/* Operands that the instruction does not take. */
+	expecterror(ctx, "\tnop\n\tjnz\n", 2, "arguments not correct");
+	expecterror(ctx, "\trlc a\n", 1, "arguments not correct");
+	expecterror(ctx, "\tmov a\n", 1, "arguments not correct");
+	expecterror(ctx, "\tpush sp\n", 1, "sp may not be used with push");
+	expecterror(ctx, "\tlxi psw, 0\n", 1, "psw may not be used with lxi");
+	expecterror(ctx, "\tstax h\n", 1, "stax operates on registers b and d");
+	expecterror(ctx, "\tmvi q, 1\n", 1, "invalid register q");
+	expecterror(ctx, "\tmvi A, 1\n", 1, "invalid register A");
+	expecterror(ctx, "\trst 8\n", 1, "invalid reset vector 8");
+	expecterror(ctx, "\tfoo\n", 1, "unknown mnemonic: foo");
+
+	/* Labels, forward or not, and the placement of each line. */
+	expectcode(ctx, "\torg 100h\nstart:\tjc next\nnext:\tjmp start\n", "da0301c30001");
+	expectcode(ctx, "l: hlt\n\tdw l\n\tdb 'ab'\n\tds 2\n\tdb 1\n", "76000061620000" "01");
+
+	a80_free(ctx);
+}
+
+static void
+testnumbers(void)
+{
+	struct a80 *ctx = newctx();
+
+	expectcode(ctx, "\tdb 255\n\tdb 10d\n\tdw 65535\n", "ff0affff");
+	expectcode(ctx, "\tdb 0x1f\n\tdb 0X1F\n\tdb 1fh\n\tdb 1FH\n", "1f1f1f1f");
+	expectcode(ctx, "\tdw 0ffffh\n\tdb 0\n\tdb 0b\n\tdb 0d\n", "ffff000000");
+	expectcode(ctx, "\tdb 101b\n\tdb 17o\n\tdb 17q\n", "050f0f");
+	expectcode(ctx, "\tdb 'a'\n\tmvi a, ' '\n", "613e20");
+
+	expecterror(ctx, "\tmvi a, 256\n", 1, "number 256 out of range");
+	expecterror(ctx, "\tdw 65536\n", 1, "number 65536 out of range");
+	expecterror(ctx, "\tdb 0x\n", 1, "invalid number 0x");
+	expecterror(ctx, "\tdb 12z\n", 1, "invalid number 12z");
+	expecterror(ctx, "\tdb 2b\n", 1, "invalid number 2b");
+	expecterror(ctx, "\tdb 9o\n", 1, "invalid number 9o");
+
+	/* A semicolon in quotes is a character rather than a comment. */
+	expectcode(ctx, "\tmvi a, ';'\n\tdb ';' ; x\n\tdb 'a;b' ; c\n", "3e3b3b613b62");
+	expectcode(ctx, "\tmvi a, 'x' ; ';'\n", "3e78");
+	expecterror(ctx, "\tdb 'a;b\n", 1, "unterminated string");
+
+	/* equ $ with each operator, and a divisor of zero. */
+	expectcode(ctx, "\torg 10h\na: equ $+2\nb: equ $-2\nc: equ $*2\n"
+			"d: equ $/3\ne: equ $%3\n\tdw a\n\tdw b\n\tdw c\n\tdw d\n\tdw e\n",
+			"12000e0020000500" "0100");
+	expecterror(ctx, "\thlt\nx: equ $/0\n", 2, "division by zero");
+	expecterror(ctx, "x: equ $%0\n", 1, "division by zero");
+
+	a80_free(ctx);
+}
+
+/* How generate() shapes a source. */
+struct shape {
+	size_t nlines;
+	int orgs;	/* whether an org may send code back over earlier bytes */
+	int undefined;	/* whether a reference may name no label */
+	int pad;	/* whether each line carries a comment */
+};
+
+/*
+ * Write a random source of the given shape into a buffer that the caller
+ * frees: instructions and data, labels referred to before and after they
+ * are defined, and equ $. Without shape->orgs, an org is used only to
+ * start over at 0 before the object code outgrows the address space.
+ */
+static char *
+generate(const struct shape *shape, unsigned long long seed)
+{
+	static const char *const jumps[] = { "jmp", "call", "jz", "cnc", "lxi h,", "dw", "mvi a,", "lda" };
+	static const char *const plain[] = { "nop", "mov a, b", "inr c", "xra a", "push h", "pop h", "ret", "hlt" };
+	size_t nlabels = shape->nlines / 4 + 1, defined = 0, nequs = 0;
+	size_t cap = (shape->nlines + nlabels) * 96 + 64, n = 0;
+	unsigned long addr = 0;
+	char *buf = malloc(cap);
+
+	if (buf == NULL) {
+		perror("a80test");
+		exit(EXIT_FAILURE);
+	}
+	rng = seed ? seed : 1;
+	for (size_t i = 0; i < shape->nlines; ++i) {
+		unsigned long r = rand32(), v = rand32();
+		const char *pad = shape->pad && r % 2 ? "\t; so that the source grows large" : "";
+
+		if (addr > 60000) {
+			n += snprintf(buf + n, cap - n, "\torg 0\n");
+			addr = 0;
+		}
+		switch (r % 10) {
+		case 0:
+		case 1:
+			if (defined < nlabels) {
+				n += snprintf(buf + n, cap - n, "l%zu:%s\n", defined++, pad);
+				break;
+			}
+			/* fall through */
+		case 2:
+		case 3: {
+			size_t k = v % nlabels;
+			const char *j = jumps[(v >> 16) % 8];
+			if (shape->undefined && v % 97 == 0) {
+				n += snprintf(buf + n, cap - n, "\t%s nowhere\n", j);
+			} else {
+				n += snprintf(buf + n, cap - n, "\t%s l%zu%s\n", j, k, pad);
+			}
+			addr += j[0] == 'm' || j[0] == 'd' ? 2 : 3;
+			break;
+		}
+		case 4:
+			n += snprintf(buf + n, cap - n, "\tmvi %c, %lu%s\n", "bcdehla"[v % 7],
+					(v >> 8) % 256, pad);
+			addr += 2;
+			break;
+		case 5:
+			if (v % 4 == 0) {
+				n += snprintf(buf + n, cap - n, "\tdb 'x%lu'\n", v % 1000);
+				addr += 1 + snprintf(NULL, 0, "%lu", v % 1000);
+			} else {
+				n += snprintf(buf + n, cap - n, "\tds %lu\n", v % 5);
+				addr += v % 5;
+			}
+			break;
+		case 6:
+			if (shape->orgs && v % 8 == 0) {
+				addr = v % 2 ? (v >> 8) % 64 : (v >> 8) % (addr + 1);
+				n += snprintf(buf + n, cap - n, "\torg %lu\n", addr);
+				break;
+			}
+			n += snprintf(buf + n, cap - n, "e%zu: equ $+%lu\n\tdw e%zu\n",
+					nequs, v % 16, nequs);
+			++nequs;
+			addr += 2;
+			break;
+		default:
+			n += snprintf(buf + n, cap - n, "\t%s%s\n", plain[v % 8], pad);
+			addr += 1;
+			break;
+		}
+	}
+	while (defined < nlabels) {
+		n += snprintf(buf + n, cap - n, "l%zu:\thlt\n", defined++);
+	}
+	return buf;
+}
+
+/*
+ * A single pass leaves a fixup for each reference ahead, which must not
+ * land on bytes that a later line, sent back by an org, has written since.
+ */
+static void
+teststream(void)
+{
+	struct a80 *ctx1 = newctx(), *ctx2 = newctx();
+	const char *ahead = "\torg 0\n\tjmp later\n\torg 1\n\tdb 0aah\nlater:\thlt\n";
+
+	check(assemblestream(ctx1, ahead, &image) == 0 && strcmp(hex(&image), "c3aa76") == 0,
+			"single pass over a fixup: got %s", hex(&image));
+	check(assemblestream(ctx1, "\tjmp x\n\tdb 1\n", &image) != 0
+			&& a80_errline(ctx1) == 1 && strstr(a80_error(ctx1), "x undefined"),
+			"single pass with an undefined label: %s", a80_error(ctx1));
+
+	for (unsigned long long seed = 1; seed <= 300; ++seed) {
+		struct shape shape = { 20 + seed % 200, 1, seed % 5 == 0, 0 };
+		char *src = generate(&shape, seed);
+		int ret1 = assemble(ctx1, src, &image);
+		int ret2 = assemblestream(ctx2, src, &other);
+		expectsame("single pass", seed, ret1, ctx1, ret2, ctx2);
+		free(src);
+	}
+
+	a80_free(ctx1);
+	a80_free(ctx2);
+}
+
+/*
+ * Check that lexing and emitting a large source on several threads gives
+ * what a single thread does, whether or not an org sends the pieces over
+ * one another, and that diagnostics name the same line.
+ */
+static void
+testchunks(void)
+{
+	struct a80 *ctx1 = newctx(), *ctx2 = newctx();
+
+	a80_setthreads(ctx1, 4);
+	for (unsigned long long seed = 1; seed <= 12; ++seed) {
+		struct shape shape = { 40000, seed % 2, seed % 3 == 0, 1 };
+		char *src = generate(&shape, seed);
+		size_t len = strlen(src);
+
+		if (!check(len >= 512 * 1024, "seed %llu: source of %zu bytes is too small to split",
+					seed, len)) {
+			free(src);
+			continue;
+		}
+		int ret1 = a80_assemble(ctx1, src, len, &image);
+		int ret2 = a80_assemble(ctx2, src, len, &other);
+		expectsame("threads", seed, ret1, ctx1, ret2, ctx2);
+
+		/* Define a label again, after and before the piece holding it. */
+		char *dup = malloc(len + 16);
+		if (dup == NULL) {
+			perror("a80test");
+			exit(EXIT_FAILURE);
+		}
+		memcpy(dup, src, len);
+		strcpy(dup + len, "l3:\tnop\n");
+		ret1 = a80_assemble(ctx1, dup, strlen(dup), &image);
+		ret2 = a80_assemble(ctx2, dup, strlen(dup), &other);
+		expectsame("threads with a label defined last twice", seed, ret1, ctx1, ret2, ctx2);
+		check(ret1 != 0 && strstr(a80_error(ctx1), "duplicate label l3"),
+				"seed %llu: %s", seed, a80_error(ctx1));
+
+		strcpy(dup, "l9000:\tnop\n");
+		memcpy(dup + strlen(dup), src, len + 1);
+		ret1 = a80_assemble(ctx1, dup, strlen(dup), &image);
+		ret2 = a80_assemble(ctx2, dup, strlen(dup), &other);
+		expectsame("threads with a label defined first twice", seed, ret1, ctx1, ret2, ctx2);
+		check(ret1 != 0 && strstr(a80_error(ctx1), "duplicate label l9000"),
+				"seed %llu: %s", seed, a80_error(ctx1));
+
+		free(dup);
+		free(src);
+	}
+
+	a80_free(ctx1);
+	a80_free(ctx2);
+}
+
+static struct cpu cpu;
+
+/* What came of running a program on the emulator. */
+struct run {
+	int stop;			/* how it stopped, or -1 if it did not assemble */
+	unsigned long long steps;	/* instructions executed */
+	size_t len;
+	char out[256];			/* what it printed */
+};
+
+/*
+ * Assemble src with the optimizations in flags and run it into run. Leave
+ * the cpu as it stopped.
+ */
+static void
+runsource(const char *src, int flags, struct run *run)
+{
+	struct a80 *ctx = newctx();
+
+	run->stop = -1;
+	run->steps = 0;
+	run->len = 0;
+	a80_setoptimize(ctx, flags);
+	if (check(assemble(ctx, src, &image) == 0, "%s: %zu: %s", src,
+				a80_errline(ctx), a80_error(ctx))) {
+		FILE *f = tmpfile();
+		if (f == NULL) {
+			perror("a80test");
+			exit(EXIT_FAILURE);
+		}
+		cpuinit(&cpu, &image, NULL, f);
+		run->stop = cpurun(&cpu, 1000000);
+		run->steps = cpu.steps;
+		rewind(f);
+		run->len = fread(run->out, 1, sizeof(run->out) - 1, f);
+		fclose(f);
+	}
+	run->out[run->len] = '\0';
+	a80_free(ctx);
+}
+
+/* Check that src runs until it halts, printing want. */
+static void
+expectrun(const char *src, const char *want, struct run *run)
+{
+	runsource(src, 0, run);
+	check(run->stop == CPU_HALT && strcmp(run->out, want) == 0,
+			"%s: stopped with %d, printing %s; want %s", src, run->stop,
+			run->out, want);
+}
+
+/*
+ * The BDOS of CP/M is reached through 5 whether it is called or jumped to,
+ * and only by programs that leave the bottom of memory alone. Writes to
+ * code already run discard what was decoded of it.
+ */
+static void
+testemulator(void)
+{
+	struct run run;
+
+	expectrun("\torg 100h\n\tmvi c, 9\n\tlxi d, msg\n\tcall 5\n"
+			"\tmvi c, 2\n\tmvi e, '!'\n\tcall 5\n\tjmp 0\n"
+			"msg:\tdb 'hello$'\n", "hello!", &run);
+	expectrun("\torg 100h\n\tmvi c, 2\n\tmvi e, 'k'\n\tcall 5\n\tjmp 0\n", "k", &run);
+	check(run.steps == 6, "call 5: %llu instructions, want 6", run.steps);
+	/* The program may return to CP/M rather than jump to 0. */
+	expectrun("\torg 100h\n\tmvi c, 2\n\tmvi e, 48h\n\tcall 5\n\tret\n", "H", &run);
+
+	/* A tail call, which returns to whoever called the routine. */
+	expectrun("\torg 100h\n\tlxi sp, 0\n\tcall print\n\tjmp 0\n"
+			"print:\tmvi c, 2\n\tmvi e, 't'\n\tjmp 5\n", "t", &run);
+
+	/* Code at 0 owns 5, which is then an ordinary address. */
+	expectrun("\torg 0\n\tjmp start\n\tnop\n\tnop\n\tmvi a, 'x'\n\tout 1\n\tret\n"
+			"start:\tlxi sp, 0\n\tmvi c, 2\n\tmvi e, 'y'\n\tcall 5\n\thlt\n", "x", &run);
+
+	/* Each pass around the loop changes the operand of its first mvi. */
+	expectrun("\torg 100h\nchar:\tequ $+1\nloop:\tmvi a, 'a'\n\tout 1\n\tlda char\n"
+			"\tinr a\n\tsta char\n\tcpi 'd'\n\tjnz loop\n\thlt\n", "abc", &run);
+	check(cpu.invalidated > 0, "self-modifying code discarded no blocks");
+}
+
+/*
+ * Check that src assembles to the object code spelled in before, and with
+ * the optimizations in flags to that spelled in after.
+ */
+static void
+expectoptimized(int flags, const char *src, const char *before, const char *after)
+{
+	struct a80 *ctx = newctx();
+
+	expectcode(ctx, src, before);
+	a80_setoptimize(ctx, flags);
+	expectcode(ctx, src, after);
+	a80_free(ctx);
+}
+
+/*
+ * Write a random program at 100h into a buffer that the caller frees. It
+ * branches only forward, calls routines some of which nothing calls, and
+ * prints its registers and flags before it halts, so that every rewrite of
+ * its code that changes what it computes changes what it prints.
+ */
+static char *
+randomprogram(unsigned long long seed)
+{
+	static const char *const regs = "bcdehla";
+	static const char *const alu[] = { "add", "adc", "sub", "sbb", "ana", "xra", "ora", "cmp" };
+	static const char *const imm[] = { "adi", "aci", "sui", "sbi", "ani", "xri", "ori", "cpi" };
+	static const char *const lone[] = { "rlc", "rrc", "ral", "rar", "daa", "cma", "stc", "cmc", "xchg" };
+	static const char *const jumps[] = { "jz", "jnz", "jc", "jnc", "jpe", "jpo", "jm", "jp", "jmp", "jmp" };
+	static const char *const calls[] = { "cz", "cnz", "cc", "cnc", "call" };
+	static const char *const pairs[] = { "b", "d", "h", "psw" };
+	static const char *const pairops[] = { "inx", "dcx", "dad" };
+	static const char *const subs[] = { "sub1", "sub2", "sub3" };
+	static const char *const afterzero[] = {
+		"mov b, a", "inx h", "ora a", "adc b", "push psw\n\tpop b", "sub c", "rar",
+	};
+	size_t cap = 16384, n = 0;
+	char *buf = malloc(cap);
+
+	if (buf == NULL) {
+		perror("a80test");
+		exit(EXIT_FAILURE);
+	}
+	rng = seed;
+	unsigned long nlines = 20 + rand32() % 130;
+	n += snprintf(buf + n, cap - n, "\torg 100h\n\tlxi sp, 0f000h\n\tlxi h, 2000h\n");
+	for (unsigned long i = 0; i < nlines; ++i) {
+		unsigned long r = rand32(), v = rand32();
+		n += snprintf(buf + n, cap - n, "x%lu:\n", i);
+		switch (r % 17) {
+		case 0:
+			n += snprintf(buf + n, cap - n, "\tmov %c, %c\n", regs[v % 7], regs[v / 7 % 7]);
+			break;
+		case 1:
+			n += snprintf(buf + n, cap - n, "\tmvi %c, %lu\n", regs[v % 7],
+					v / 7 % 3 ? 0 : v / 21 % 256);
+			break;
+		case 2:
+			n += snprintf(buf + n, cap - n, "\t%s %c\n", alu[v % 8], regs[v / 8 % 7]);
+			break;
+		case 3:
+			n += snprintf(buf + n, cap - n, "\t%s %lu\n", imm[v % 8], v / 8 % 256);
+			break;
+		case 4:
+			n += snprintf(buf + n, cap - n, "\t%s %c\n", v % 2 ? "inr" : "dcr",
+					regs[v / 2 % 7]);
+			break;
+		case 5:
+			n += snprintf(buf + n, cap - n, "\t%s %c\n", pairops[v % 3], "bdh"[v / 3 % 3]);
+			break;
+		case 6:
+			n += snprintf(buf + n, cap - n, "\t%s\n", lone[v % 9]);
+			break;
+		case 7:
+			n += snprintf(buf + n, cap - n, "\tsta %lu\n", 0x2000 + v % 256);
+			break;
+		case 8:
+			n += snprintf(buf + n, cap - n, "\tmvi a, 0\n");
+			break;
+		case 9: {
+			/* Near enough that a jump to the next line comes up often. */
+			unsigned long ahead = nlines - i < 3 ? nlines - i : 3;
+			n += snprintf(buf + n, cap - n, "\t%s x%lu\n", jumps[v % 10],
+					i + 1 + v / 10 % ahead);
+			break;
+		}
+		case 10:
+			n += snprintf(buf + n, cap - n, "\tpush %s\n\tpop %s\n", pairs[v % 4],
+					pairs[v / 4 % 4]);
+			break;
+		case 11:
+			n += snprintf(buf + n, cap - n, "\t%s %s\n", calls[v % 5], subs[v / 5 % 3]);
+			break;
+		case 12:
+			n += snprintf(buf + n, cap - n, "\tlxi h, %lu\n", 0x2000 + v % 256);
+			break;
+		case 13:
+			n += snprintf(buf + n, cap - n, "\tpush %s\n\tpop %s\n", pairs[v % 4],
+					pairs[v % 4]);
+			break;
+		case 14:
+			n += snprintf(buf + n, cap - n, "\tjmp x%lu\n", i + 1 + v % (nlines - i));
+			break;
+		case 15:
+			if (v % 8 == 7) {
+				n += snprintf(buf + n, cap - n, "\tmvi a, 0\n\tjz x%lu\n",
+						i + 1 + v / 8 % (nlines - i));
+			} else {
+				n += snprintf(buf + n, cap - n, "\tmvi a, 0\n\t%s\n", afterzero[v % 8]);
+			}
+			break;
+		default:
+			n += snprintf(buf + n, cap - n, "\tnop\n");
+			break;
+		}
+	}
+	n += snprintf(buf + n, cap - n, "x%lu:\n\tpush psw\n", nlines);
+	for (const char *r = "bcdehl"; *r != '\0'; ++r) {
+		n += snprintf(buf + n, cap - n, "\tmov a, %c\n\tout 1\n", *r);
+	}
+	snprintf(buf + n, cap - n,
+			"\tpop h\n\tmov a, h\n\tout 1\n\tmov a, l\n\tout 1\n\thlt\n"
+			"sub1:\tinr e\n\trz\n\txra d\n\tcall sub3\n\tret\n"
+			"dead:\tmvi a, 1\n\tcall dead2\n\tret\n"
+			"dead2:\tinr a\n\tret\n"
+			"sub2:\tjmp sub1\n"
+			"sub3:\tmvi a, 0\n\tpush d\n\tpop d\n\tadd e\n\tret\n");
+	return buf;
+}
+
+/*
+ * Check that random programs, assembled with the optimizations in flags,
+ * print what they do without them and take no more instructions to.
+ */
+static void
+expectsameruns(int flags, unsigned long long nseeds)
+{
+	static struct run plain, optimized;
+
+	for (unsigned long long seed = 1; seed <= nseeds; ++seed) {
+		char *src = randomprogram(seed);
+
+		runsource(src, 0, &plain);
+		runsource(src, flags, &optimized);
+		check(plain.stop == CPU_HALT && optimized.stop == plain.stop
+				&& optimized.len == plain.len
+				&& memcmp(optimized.out, plain.out, plain.len) == 0
+				&& optimized.steps <= plain.steps,
+				"optimizations %d, seed %llu: stopped with %d and %d after %llu and %llu instructions",
+				flags, seed, plain.stop, optimized.stop, plain.steps, optimized.steps);
+		free(src);
+	}
+}
+
+/*
+ * Each rewrite of -O, on its own and where it must be held back, and then
+ * all of them at once on random programs.
+ */
+static void
+testpeephole(void)
+{
+	struct run run;
+
+	/* A jump to a jmp goes where that jmp goes. */
+	expectoptimized(A80_PEEPHOLE, "\torg 100h\n\tjmp a\n\thlt\na:\tjmp b\n\thlt\nb:\thlt\n",
+			"c30401" "76" "c30801" "76" "76", "c30801" "76" "c30801" "76" "76");
+	/* call x then ret is jmp x, and x moves back over the ret. */
+	expectoptimized(A80_PEEPHOLE, "\torg 100h\n\tcall f\n\tret\nf:\thlt\n",
+			"cd0401" "c9" "76", "c30301" "76");
+	/* A jump to the next instruction is dropped. */
+	expectoptimized(A80_PEEPHOLE, "\torg 100h\n\tjz n\nn:\thlt\n",
+			"ca0301" "76", "76");
+	/* mvi a, 0 is xra a if the flags are set before they are read... */
+	expectoptimized(A80_PEEPHOLE, "\torg 100h\n\tmvi a, 0\n\tora b\n\thlt\n",
+			"3e00" "b0" "76", "af" "b0" "76");
+	/* ...and not if they are read first. */
+	expectoptimized(A80_PEEPHOLE, "\torg 100h\nx:\tmvi a, 0\n\tjz x\n",
+			"3e00" "ca0001", "3e00" "ca0001");
+	/* push then pop of the same pair is dropped, unless a label parts them. */
+	expectoptimized(A80_PEEPHOLE, "\torg 100h\n\tpush b\n\tpop b\n\thlt\n",
+			"c5" "c1" "76", "76");
+	expectoptimized(A80_PEEPHOLE, "\torg 100h\n\tpush b\nl:\tpop b\n\tjmp l\n",
+			"c5" "c1" "c30101", "c5" "c1" "c30101");
+	expectoptimized(A80_PEEPHOLE, "\torg 100h\n\tpush b\n\tpop d\n\thlt\n",
+			"c5" "d1" "76", "c5" "d1" "76");
+	/* Code among the reset vectors never moves. */
+	expectoptimized(A80_PEEPHOLE, "\torg 0\n\tpush b\n\tpop b\n\thlt\n",
+			"c5" "c1" "76", "c5" "c1" "76");
+	/* Nor does code whose addresses the source spells by number. */
+	expectoptimized(A80_PEEPHOLE, "\torg 100h\n\tjmp a\na:\tjmp 106h\n\thlt\n\thlt\n",
+			"c30301" "c30601" "76" "76", "c30601" "c30601" "76" "76");
+	/* What follows an org or ds in the source does not follow in memory. */
+	expectoptimized(A80_PEEPHOLE, "\torg 100h\n\tmvi a, 0\n\torg 103h\n\tadd b\n\thlt\n",
+			"3e00" "00" "80" "76", "3e00" "00" "80" "76");
+	runsource("\torg 100h\n\tmvi a, 76h\n\tsta buf\n\tjmp go\nbuf:\tds 1\n"
+			"go:\tmvi a, 'Y'\n\tout 1\n\thlt\n", A80_PEEPHOLE, &run);
+	check(run.stop == CPU_HALT && strcmp(run.out, "Y") == 0,
+			"jmp over ds: stopped with %d, printing %s; want Y", run.stop, run.out);
+
+	expectsameruns(A80_PEEPHOLE, 200);
+}
+
+/*
+ * What -D keeps and drops, and in particular which block a root marks,
+ * and then random programs run with -D, alone and with -O.
+ */
+static void
+testprune(void)
+{
+	/* The example of the readme: root marks the handler after it. */
+	expectoptimized(A80_PRUNE,
+			"\torg 100h\n\tcall f\n\tjmp 0\nunused:\tmvi a, 1\n\tret\n"
+			"\troot\nhandler: push psw\n\tpop psw\n\tret\nf:\tret\n",
+			"cd0c01" "c30000" "3e01" "c9" "f5" "f1" "c9" "c9",
+			"cd0901" "c30000" "f5" "f1" "c9" "c9");
+	/* A root on the line of a label, or after it, marks its block. */
+	expectoptimized(A80_PRUNE, "\torg 100h\n\tret\nkept:\troot\n\tnop\n\tret\n",
+			"c9" "00" "c9", "c9" "00" "c9");
+	expectoptimized(A80_PRUNE, "\torg 100h\n\tret\nkept:\n\troot\n\tnop\n\tret\n",
+			"c9" "00" "c9", "c9" "00" "c9");
+	expectoptimized(A80_PRUNE, "\torg 100h\n\tret\ngone:\tnop\n\tret\n",
+			"c9" "00" "c9", "c9");
+	/* One after the code of a block marks the next block instead. */
+	expectoptimized(A80_PRUNE, "\torg 100h\n\tret\nold:\tnop\n\troot\n\tret\nnext:\tret\n",
+			"c9" "00" "c9" "c9", "c9" "c9");
+	/* A block kept runs into the next, unless it ends in a jmp or ret. */
+	expectoptimized(A80_PRUNE, "\torg 100h\n\tnop\na:\tjmp c\nb:\tnop\nc:\thlt\n",
+			"00" "c30501" "00" "76", "00" "c30401" "76");
+	/* Nothing goes from among the reset vectors... */
+	expectoptimized(A80_PRUNE, "\torg 0\n\thlt\nisr:\tei\n\tret\n",
+			"76" "fb" "c9", "76" "fb" "c9");
+	/* ...nor from code whose addresses the source spells by number. */
+	expectoptimized(A80_PRUNE, "\torg 100h\n\tjmp 104h\nx:\tnop\n\thlt\n",
+			"c30401" "00" "76", "c30401" "00" "76");
+
+	expectsameruns(A80_PRUNE, 200);
+	expectsameruns(A80_PRUNE | A80_PEEPHOLE, 200);
+}
+
+/*
+ * Check that src fails at line with a diagnosis containing want, whether it
+ * is assembled in two passes or in one.
+ */
+static void
+expecterrors(struct a80 *ctx, const char *src, size_t line, const char *want)
+{
+	expecterror(ctx, src, line, want);
+	check(assemblestream(ctx, src, &image) != 0 && a80_errline(ctx) == line
+			&& strstr(a80_error(ctx), want) != NULL,
+			"%s: in one pass, %zu: %s; want %zu: %s", src, a80_errline(ctx),
+			a80_error(ctx), line, want);
+}
+
+/*
+ * A tmax times the instructions from it to the next label, taking in any
+ * labels that come before the first of them.
+ */
+static void
+testbudgets(void)
+{
+	struct a80 *ctx = newctx();
+
+	expectcode(ctx, "\ttmax 8\n\tnop\n\tnop\nx:\tnop\n\tnop\n\tnop\n", "0000000000");
+	expecterrors(ctx, "\ttmax 7\n\tnop\n\tnop\nx:\tnop\n", 1, "8 T-states, over its budget of 7");
+	expectcode(ctx, "x:\ttmax 14\n\tjmp x\n\tnop\n", "c3000000");
+	expecterrors(ctx, "x:\ttmax 13\n\tjmp x\n\tnop\n", 1, "over its budget of 13");
+
+	/* On the line before a label, or between the label and its code. */
+	expectcode(ctx, "\ttmax 18\nloop:\tnop\n\tnop\n\tjmp loop\n", "0000c30000");
+	expecterrors(ctx, "\ttmax 17\nloop:\tnop\n\tnop\n\tjmp loop\n", 1, "18 T-states");
+	expecterrors(ctx, "\ttmax 4\nfar:\nloop:\n\tnop\n\tnop\n", 1, "8 T-states");
+	expecterrors(ctx, "loop:\n\ttmax 4\n\tnop\n\tnop\n", 2, "8 T-states");
+
+	/* Space, data and equ are not instructions, and do not end a block. */
+	expecterrors(ctx, "\ttmax 4\n\tds 2\nn:\tequ 3\n\tnop\n\tnop\n", 1, "8 T-states");
+
+	/* A tmax with nothing under it. */
+	expecterrors(ctx, "\tnop\n\ttmax 10\n", 2, "no instructions under tmax");
+	expecterrors(ctx, "\ttmax 10\n\ttmax 10\n\tnop\n", 1, "no instructions under tmax");
+	expecterrors(ctx, "\ttmax 10\nx:\n", 1, "no instructions under tmax");
+
+	a80_free(ctx);
+}
+
+/* A source held as lines, to be edited between assemblies. */
+#define MAXLINES 256
+
+struct text {
+	char *lines[MAXLINES];
+	size_t n;
+	unsigned long nnames;	/* labels named so far */
+};
+
+/*
+ * Return a random line for text, which may define a new label and may
+ * refer to one that text defines already.
+ */
+static char *
+randomline(struct text *text)
+{
+	char line[96], name[24] = "", ref[24];
+	size_t n = 0;
+
+	if (rand32() % 3 == 0) {
+		snprintf(name, sizeof(name), "u%lu", ++text->nnames);
+	}
+	snprintf(ref, sizeof(ref), "%lu", rand32() % 300);
+	for (int tries = 0; tries < 8 && text->n > 0; ++tries) {
+		const char *l = text->lines[rand32() % text->n];
+		const char *colon = strchr(l, ':');
+		if (l[0] == 'u' && colon != NULL && colon - l < (long)sizeof(ref)) {
+			snprintf(ref, sizeof(ref), "%.*s", (int)(colon - l), l);
+			break;
+		}
+	}
+	if (rand32() % 400 == 0) {
+		snprintf(ref, sizeof(ref), "nowhere");
+	}
+
+	switch (rand32() % 16) {
+	case 4:
+	case 5:
+	case 12:
+		if (name[0] == '\0') {
+			snprintf(name, sizeof(name), "u%lu", ++text->nnames);
+		}
+		snprintf(line, sizeof(line), "%s: equ %s%lu", name,
+				(const char *[]){ "$+", "", "$*" }[rand32() % 3], rand32() % 9 + 1);
+		return strdup(line);
+	case 6:
+		snprintf(line, sizeof(line), "\torg %lu", rand32() % 4 * 2000 + rand32() % 3);
+		return strdup(line);
+	case 11:
+		return strdup("; a comment");
+	}
+
+	if (name[0] != '\0') {
+		n = snprintf(line, sizeof(line), "%s:", name);
+	}
+	switch (rand32() % 8) {
+	case 0: snprintf(line + n, sizeof(line) - n, "\tjmp %s", ref); break;
+	case 1: snprintf(line + n, sizeof(line) - n, "\tlxi h, %s", ref); break;
+	case 2: snprintf(line + n, sizeof(line) - n, "\tdw %s", ref); break;
+	case 3: snprintf(line + n, sizeof(line) - n, "\tdb 'hi%lu'", rand32() % 5); break;
+	case 4: snprintf(line + n, sizeof(line) - n, "\tds %lu", rand32() % 4); break;
+	case 5: snprintf(line + n, sizeof(line) - n, "\tmvi b, %lu", rand32() % 200); break;
+	case 6: break;
+	default: snprintf(line + n, sizeof(line) - n, "\tinx h"); break;
+	}
+	return strdup(line);
+}
+
+/* Insert, delete or replace a few lines of text at random. */
+static void
+edit(struct text *text)
+{
+	for (unsigned long k = rand32() % 3 + 1; k > 0; --k) {
+		size_t at = rand32() % (text->n + 1);
+		unsigned long op = rand32() % 3;
+
+		if (op == 0 && text->n < MAXLINES) {
+			memmove(text->lines + at + 1, text->lines + at,
+					(text->n - at) * sizeof(char *));
+			text->lines[at] = randomline(text);
+			++text->n;
+		} else if (op == 1 && at < text->n) {
+			free(text->lines[at]);
+			memmove(text->lines + at, text->lines + at + 1,
+					(text->n - at - 1) * sizeof(char *));
+			--text->n;
+		} else if (at < text->n) {
+			char *line = randomline(text);
+			free(text->lines[at]);
+			text->lines[at] = line;
+		}
+	}
+}
+
+/* Join the lines of text into buf, with or without a final newline. */
+static size_t
+join(const struct text *text, char *buf, int trailing)
+{
+	size_t len = 0;
+
+	for (size_t i = 0; i < text->n; ++i) {
+		size_t n = strlen(text->lines[i]);
+		memcpy(buf + len, text->lines[i], n);
+		len += n;
+		if (i + 1 < text->n || trailing) {
+			buf[len++] = '\n';
+		}
+	}
+	buf[len] = '\0';
+	return len;
+}
+
+/*
+ * Edit sources at random and check that bringing the resident assembly up
+ * to date with each revision gives what assembling it afresh does.
+ */
+static void
+testreassemble(void)
+{
+	static char buf[MAXLINES * 96];
+
+	for (unsigned long long seed = 1; seed <= 100; ++seed) {
+		struct a80 *ctx1 = newctx(), *ctx2 = newctx();
+		struct text text = { { NULL }, 0, 0 };
+
+		rng = seed;
+		for (size_t n = rand32() % 60; text.n < n; ) {
+			text.lines[text.n] = randomline(&text);
+			++text.n;
+		}
+		for (int revision = 0; revision < 30; ++revision) {
+			size_t len = join(&text, buf, rand32() % 4 != 0);
+			int ret1 = a80_reassemble(ctx1, buf, len, &image);
+			int ret2 = a80_assemble(ctx2, buf, len, &other);
+			expectsame("reassembly", seed, ret1, ctx1, ret2, ctx2);
+			edit(&text);
+		}
+
+		for (size_t i = 0; i < text.n; ++i) {
+			free(text.lines[i]);
+		}
+		a80_free(ctx1);
+		a80_free(ctx2);
+	}
+}
+
+static const struct {
+	const char *name;
+	void (*run)(void);
+} suites[] = {
+	{ "encodings", testencodings },
+	{ "numbers", testnumbers },
+	{ "stream", teststream },
+	{ "chunks", testchunks },
+	{ "reassemble", testreassemble },
+	{ "emulator", testemulator },
+	{ "peephole", testpeephole },
+	{ "prune", testprune },
+	{ "budgets", testbudgets },
+};
+
+int
+main(int argc, char *argv[])
+{
+	for (size_t i = 0; i < sizeof(suites) / sizeof(suites[0]); ++i) {
+		int selected = argc < 2;
+		for (int j = 1; j < argc; ++j) {
+			selected |= strcmp(argv[j], suites[i].name) == 0;
+		}
+		if (selected) {
+			suite = suites[i].name;
+			suites[i].run();
+		}
+	}
+
+	printf("%d checks, %d failed\n", nchecks, nfailed);
+	exit(nfailed > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+}